@@ -66,6 +66,15 @@
 #  error "base.h: Unsupported compiler"
 #endif
 
+#if !defined(BASE_COMPILER_TCC) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define BASE_SIMD_SSE2
+#  if defined(__AVX2__)
+#    define BASE_SIMD_AVX2
+#  endif
+#elif !defined(BASE_COMPILER_TCC) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#  define BASE_SIMD_NEON
+#endif
+
 #if defined(__STDC_VERSION__)
 #  if (__STDC_VERSION__ >= 202311L)
 #    define C_STANDARD_C23
@@ -83,14 +92,8 @@
 #    error "base.h: Unsupported C version, C99+"
 #  endif
 #else
-#  if defined(BASE_COMPILER_MSVC)
-#    if defined(_MSC_VER) && _MSC_VER >= 1920 // >= Visual Studio 2019
-#      define C_STANDARD_C17
-#      define C_STANDARD "C17"
-#    else
-#      define C_STANDARD_C11
-#      define C_STANDARD "C11"
-#    endif
+#  if defined(BASE_COMPILER_MSVC) // without /std:c11 MSVC has no _Generic, which HashMap needs for String keys
+#    error "base.h: MSVC needs /std:c11 or newer"
 #  endif
 #endif
 
@@ -108,13 +111,26 @@
 #  include <errno.h>
 #  include <fcntl.h>
 #  include <limits.h>
+#  include <pthread.h>
+#  include <sys/mman.h>
 #  include <sys/stat.h>
 #  include <sys/types.h>
+#  include <sys/uio.h>
 #  include <unistd.h>
 #endif
 
+#if defined(BASE_SIMD_AVX2)
+#  include <immintrin.h>
+#elif defined(BASE_SIMD_SSE2)
+#  include <emmintrin.h>
+#elif defined(BASE_SIMD_NEON)
+#  include <arm_neon.h>
+#endif
+
 #include <ctype.h>
+#include <float.h>
 #include <inttypes.h>
+#include <math.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -160,6 +176,9 @@ typedef struct {
 #  define UNLIKELY(x) __builtin_expect(!!(x), 0)
 #  define FORMAT_CHECK(fmt_pos, args_pos) __attribute__((format(printf, fmt_pos, args_pos)))
 #  define WARN_UNUSED __attribute__((warn_unused_result))
+#  define MAYBE_UNUSED __attribute__((unused))
+#  define THREAD_LOCAL __thread
+#  define ALIGNAS(al) __attribute__((aligned(al)))
 
 #  if (GCC_VERSION >= 1100)
 #    define ATTR_MALLOC_DEALLOC(fn) __attribute__((malloc(fn, 1)))
@@ -177,6 +196,9 @@ typedef struct {
 #  define UNLIKELY(x) x
 #  define FORMAT_CHECK(fmt_pos, args_pos)
 #  define WARN_UNUSED _Check_return_
+#  define MAYBE_UNUSED
+#  define THREAD_LOCAL __declspec(thread)
+#  define ALIGNAS(al) _Alignas(al)
 
 #  define ATTR_MALLOC_DEALLOC(fn)
 #else
@@ -190,6 +212,9 @@ typedef struct {
 #  define UNLIKELY(x) x
 #  define FORMAT_CHECK(fmt_pos, args_pos)
 #  define WARN_UNUSED
+#  define MAYBE_UNUSED
+#  define THREAD_LOCAL // NOTE: TCC has no TLS, thread locals become regular globals, see __ThreadLocals
+#  define ALIGNAS(al) __attribute__((aligned(al)))
 
 #  define ATTR_MALLOC_DEALLOC(fn)
 #endif
@@ -228,13 +253,40 @@ WARN_UNUSED errno_t memcpy_s(void *dest, size_t destSize, const void *src, size_
 
 #endif
 
+/*   }}} --- Allocator Definitions --- {{{   */
+/* Allocation interface so containers can live in the heap, an arena or a pool. A zeroed
+   `Allocator` is the heap. `resize` with a NULL `ptr` allocates, `free` may be a no-op. */
+typedef struct {
+  void *(*alloc)(void *context, size_t size, size_t align);
+  void *(*resize)(void *context, void *ptr, size_t old_size, size_t new_size, size_t align);
+  void (*free)(void *context, void *ptr, size_t size);
+  void *context;
+} Allocator;
+
+void *AllocatorAlloc(Allocator allocator, size_t size, size_t align) RETURNS_NON_NULL;
+void *AllocatorResize(Allocator allocator, void *ptr, size_t old_size, size_t new_size, size_t align) RETURNS_NON_NULL;
+void AllocatorFree(Allocator allocator, void *ptr, size_t size);
+
+/* Allocating container macros pass their call site down with `__BASE_CALLER`, so `BASE_TRACK_ALLOC`
+   buckets the memory at the user's line instead of inside base.h */
+#define __BASE_CALLER FILE_NAME, __LINE__
+void *__base_allocator_alloc_at(Allocator allocator, size_t size, size_t align, const char *file, uint32_t line) RETURNS_NON_NULL;
+void *__base_allocator_resize_at(Allocator allocator, void *ptr, size_t old_size, size_t new_size, size_t align, const char *file, uint32_t line) RETURNS_NON_NULL;
+
 /*   }}} --- Vector Definitions --- {{{   */
 typedef int32_t (*CompareFunc)(const void *a, const void *b);
 
-int32_t __base_vec_partition(void **data, size_t element_size, CompareFunc compare, int32_t low, int32_t high);
-void __base_vec_quicksort(void **data, size_t element_size, CompareFunc compare, int32_t low, int32_t high);
+/* Pattern-defeating quicksort: ninther pivots, insertion sort on small ranges, heapsort
+   once partitions keep coming out unbalanced. Not stable, no allocations. */
+#define VecSort(vector, compare) __base_vec_sort((vector).data, (vector).length, sizeof(*(vector).data), compare)
+void __base_vec_sort(void *data, size_t length, size_t element_size, CompareFunc compare);
 
-#define VecSort(vector, compare) __base_vec_quicksort((void **)&(vector).data, sizeof(*(vector).data), compare, 0, (vector).length - 1)
+/* VecSort over `threads` workers (0 means one per core): every worker sorts a slice, then slices
+   merge pairwise with each merge split between the workers again. Allocates a scratch copy of the
+   vector, the Stable version also keeps equal elements in their original order */
+#define VecSortParallel(vector, compare, threads) __base_vec_sort_parallel((vector).data, (vector).length, sizeof(*(vector).data), compare, threads, false)
+#define VecSortParallelStable(vector, compare, threads) __base_vec_sort_parallel((vector).data, (vector).length, sizeof(*(vector).data), compare, threads, true)
+void __base_vec_sort_parallel(void *data, size_t length, size_t element_size, CompareFunc compare, size_t threads, bool stable);
 
 #define VEC_TYPE(typeName, valueType) \
   typedef struct {                    \
@@ -243,14 +295,32 @@ void __base_vec_quicksort(void **data, size_t element_size, CompareFunc compare,
     size_t capacity;                  \
   } typeName
 
+/* Growth policy: the first allocation holds VEC_MIN_CAPACITY elements and every later one
+   VEC_GROWTH(capacity), both can be defined before including base.h */
+#ifndef VEC_MIN_CAPACITY
+#  define VEC_MIN_CAPACITY 128
+#endif
+#ifndef VEC_GROWTH
+#  define VEC_GROWTH(capacity) ((capacity) * 2)
+#endif
+// Always grows by at least one, a policy like `capacity * 3 / 2` would otherwise stall at 1
+#define __BASE_VEC_GROWTH(capacity) Max(VEC_GROWTH(capacity), (capacity) + 1)
+
 #define VecReserve(vector, count)                           \
   do {                                                      \
     vector.capacity = (count);                              \
     vector.data = Malloc((count) * sizeof(*(vector).data)); \
   } while (0)
 
-#define VecPush(vector, value) __base_vec_push((void **)&(vector).data, &(vector).length, &(vector).capacity, sizeof(*(vector).data), &(value));
-void __base_vec_push(void **data, size_t *length, size_t *capacity, size_t element_size, void *value);
+/* Stores `value` straight into the next slot, the call out only happens when the vector grows */
+#define VecPush(vector, value)                                                                                                                    \
+  do {                                                                                                                                            \
+    if ((vector).length >= (vector).capacity) {                                                                                                   \
+      __base_vec_grow((Allocator){0}, (void **)&(vector).data, (vector).length, &(vector).capacity, (vector).length + 1, sizeof(*(vector).data), __BASE_CALLER); \
+    }                                                                                                                                             \
+    (vector).data[(vector).length++] = (value);                                                                                                   \
+  } while (0)
+void __base_vec_grow(Allocator allocator, void **data, size_t length, size_t *capacity, size_t needed, size_t element_size, const char *file, uint32_t line);
 
 #define VecPop(vector) __base_vec_pop((vector).data, &(vector).length, sizeof(*(vector).data));
 void *__base_vec_pop(void *data, size_t *length, size_t element_size);
@@ -258,11 +328,33 @@ void *__base_vec_pop(void *data, size_t *length, size_t element_size);
 #define VecShift(vector) __base_vec_shift((void **)&(vector).data, &(vector).length, sizeof(*(vector).data))
 void __base_vec_shift(void **data, size_t *length, size_t element_size);
 
-#define VecUnshift(vector, value) __base_vec_unshift((void **)&(vector).data, &(vector).length, &(vector).capacity, sizeof(*(vector).data), &(value))
-void __base_vec_unshift(void **data, size_t *length, size_t *capacity, size_t element_size, const void *value);
+#define VecUnshift(vector, value) __base_vec_unshift((void **)&(vector).data, &(vector).length, &(vector).capacity, sizeof(*(vector).data), &(value), __BASE_CALLER)
+void __base_vec_unshift(void **data, size_t *length, size_t *capacity, size_t element_size, const void *value, const char *file, uint32_t line);
+
+#define VecInsert(vector, value, index) __base_vec_insert((void **)&(vector).data, &(vector).length, &(vector).capacity, sizeof(*(vector).data), &(value), (index), __BASE_CALLER)
+void __base_vec_insert(void **data, size_t *length, size_t *capacity, size_t element_size, void *value, size_t index, const char *file, uint32_t line);
+
+/* Appends `count` elements from `values` with a single capacity check and copy, `values` may
+   point into the vector itself (`VecExtend(vector, vector)`). The *With forms take the allocator */
+#define VecPushMany(vector, values, count) VecPushManyWith(vector, values, count, (Allocator){0})
+#define VecPushManyWith(vector, values, count, allocator) \
+  __base_vec_push_many((allocator), (void **)&(vector).data, &(vector).length, &(vector).capacity, sizeof(*(vector).data), (values), (count), __BASE_CALLER)
+void __base_vec_push_many(Allocator allocator, void **data, size_t *length, size_t *capacity, size_t element_size, const void *values, size_t count, const char *file, uint32_t line);
 
-#define VecInsert(vector, value, index) __base_vec_insert((void **)&(vector).data, &(vector).length, &(vector).capacity, sizeof(*(vector).data), &(value), (index))
-void __base_vec_insert(void **data, size_t *length, size_t *capacity, size_t element_size, void *value, size_t index);
+#define VecExtend(vector, other) VecPushMany(vector, (other).data, (other).length)
+#define VecExtendWith(vector, other, allocator) VecPushManyWith(vector, (other).data, (other).length, allocator)
+
+/* Sets the length, new elements are zeroed */
+#define VecResize(vector, new_length) VecResizeWith(vector, new_length, (Allocator){0})
+#define VecResizeWith(vector, new_length, allocator) \
+  __base_vec_resize((allocator), (void **)&(vector).data, &(vector).length, &(vector).capacity, sizeof(*(vector).data), (new_length), __BASE_CALLER)
+void __base_vec_resize(Allocator allocator, void **data, size_t *length, size_t *capacity, size_t element_size, size_t new_length, const char *file, uint32_t line);
+
+/* Reallocates so `capacity == length`, frees the buffer when empty */
+#define VecShrinkToFit(vector) VecShrinkToFitWith(vector, (Allocator){0})
+#define VecShrinkToFitWith(vector, allocator) \
+  __base_vec_shrink_to_fit((allocator), (void **)&(vector).data, &(vector).length, &(vector).capacity, sizeof(*(vector).data), __BASE_CALLER)
+void __base_vec_shrink_to_fit(Allocator allocator, void **data, size_t *length, size_t *capacity, size_t element_size, const char *file, uint32_t line);
 
 #define VecAt(vector, index) (*(__typeof__(*(vector).data) *)__base_vec_at((void **)&(vector).data, &(vector).length, index, sizeof(*(vector).data)))
 void *__base_vec_at(void **data, size_t *length, size_t index, size_t elementSize);
@@ -272,8 +364,298 @@ void *__base_vec_at(void **data, size_t *length, size_t index, size_t elementSiz
 #define VecFree(vector) __base_vec_free((void **)&(vector).data, &(vector).length, &(vector).capacity)
 void __base_vec_free(void **data, size_t *length, size_t *capacity);
 
+/* Same as above on memory from `allocator`, a vector must always use the same one */
+#define VecReserveWith(vector, count, allocator)                                                               \
+  do {                                                                                                        \
+    (vector).capacity = (count);                                                                              \
+    (vector).data = AllocatorAlloc((allocator), (count) * sizeof(*(vector).data), DEFAULT_ALIGNMENT); \
+  } while (0)
+
+#define VecPushWith(vector, value, allocator)                                                                                                  \
+  do {                                                                                                                                         \
+    if ((vector).length >= (vector).capacity) {                                                                                                \
+      __base_vec_grow((allocator), (void **)&(vector).data, (vector).length, &(vector).capacity, (vector).length + 1, sizeof(*(vector).data), __BASE_CALLER); \
+    }                                                                                                                                          \
+    (vector).data[(vector).length++] = (value);                                                                                                \
+  } while (0)
+
+#define VecFreeWith(vector, allocator) __base_vec_free_with((allocator), (void **)&(vector).data, &(vector).length, &(vector).capacity, sizeof(*(vector).data))
+void __base_vec_free_with(Allocator allocator, void **data, size_t *length, size_t *capacity, size_t element_size);
+
 #define VecForEach(vector, it) for (__typeof__(*(vector).data) *(it) = (vector).data; (vector).data && (it) < (vector).data + (vector).length; (it)++)
 
+#define __BASE_SORT_INSERTION_THRESHOLD 24
+#define __BASE_SORT_NINTHER_THRESHOLD 128
+#define __BASE_SORT_PARTIAL_LIMIT 8
+
+/* Generates `static void name(type *data, size_t length)`, the same sort as VecSort but with
+   `less_expr` inlined, it sees `a` and `b` as `const type *`:
+     VEC_SORT_IMPL(SortByAge, Person, a->age < b->age);
+     VecSortTyped(people, SortByAge); */
+#define VEC_SORT_IMPL(name, type, less_expr)                                                    \
+  MAYBE_UNUSED static inline bool name##__less(const type *a, const type *b) {                  \
+    return (less_expr);                                                                         \
+  }                                                                                             \
+  MAYBE_UNUSED static inline void name##__swap(type *x, type *y) {                              \
+    type tmp = *x;                                                                              \
+    *x = *y;                                                                                    \
+    *y = tmp;                                                                                   \
+  }                                                                                             \
+  MAYBE_UNUSED static bool name##__insertion(type *data, size_t lo, size_t hi, size_t limit) {  \
+    size_t moved = 0;                                                                           \
+    for (size_t i = lo + 1; i < hi; i++) {                                                      \
+      type value = data[i];                                                                     \
+      size_t j = i;                                                                             \
+      for (; j > lo && name##__less(&value, &data[j - 1]); j--) data[j] = data[j - 1];          \
+      data[j] = value;                                                                          \
+      moved += i - j;                                                                           \
+      if (moved > limit) return false;                                                          \
+    }                                                                                           \
+    return true;                                                                                \
+  }                                                                                             \
+  MAYBE_UNUSED static void name##__sift_down(type *data, size_t root, size_t length) {          \
+    size_t child;                                                                               \
+    while ((child = 2 * root + 1) < length) {                                                   \
+      if (child + 1 < length && name##__less(&data[child], &data[child + 1])) child++;          \
+      if (!name##__less(&data[root], &data[child])) return;                                     \
+      name##__swap(&data[root], &data[child]);                                                  \
+      root = child;                                                                             \
+    }                                                                                           \
+  }                                                                                             \
+  MAYBE_UNUSED static void name##__sort3(type *data, size_t x, size_t y, size_t z) {            \
+    if (name##__less(&data[y], &data[x])) name##__swap(&data[x], &data[y]);                     \
+    if (name##__less(&data[z], &data[y])) {                                                     \
+      name##__swap(&data[y], &data[z]);                                                         \
+      if (name##__less(&data[y], &data[x])) name##__swap(&data[x], &data[y]);                   \
+    }                                                                                           \
+  }                                                                                             \
+  MAYBE_UNUSED static void name##__loop(type *data, size_t lo, size_t hi, size_t bad_allowed) { \
+    while (hi - lo > __BASE_SORT_INSERTION_THRESHOLD) {                                         \
+      size_t length = hi - lo, mid = lo + length / 2;                                           \
+      if (length > __BASE_SORT_NINTHER_THRESHOLD) {                                             \
+        name##__sort3(data, lo, mid, hi - 1);                                                   \
+        name##__sort3(data, lo + 1, mid - 1, hi - 2);                                           \
+        name##__sort3(data, lo + 2, mid + 1, hi - 3);                                           \
+        name##__sort3(data, mid - 1, mid, mid + 1);                                             \
+      } else {                                                                                  \
+        name##__sort3(data, lo, mid, hi - 1);                                                   \
+      }                                                                                         \
+      name##__swap(&data[lo], &data[mid]);                                                      \
+      size_t i = lo, j = hi;                                                                    \
+      bool swapped = false;                                                                     \
+      for (;;) {                                                                                \
+        while (name##__less(&data[++i], &data[lo]) && i != hi - 1) {}                           \
+        while (name##__less(&data[lo], &data[--j]) && j != lo) {}                               \
+        if (i >= j) break;                                                                      \
+        name##__swap(&data[i], &data[j]);                                                       \
+        swapped = true;                                                                         \
+      }                                                                                         \
+      name##__swap(&data[lo], &data[j]);                                                        \
+      size_t pivot = j, left = pivot - lo, right = hi - pivot - 1;                              \
+      if (left < length / 8 || right < length / 8) {                                            \
+        if (--bad_allowed == 0) {                                                               \
+          for (size_t k = length / 2; k-- > 0;) name##__sift_down(data + lo, k, length);        \
+          for (size_t end = length - 1; end > 0; end--) {                                       \
+            name##__swap(&data[lo], &data[lo + end]);                                           \
+            name##__sift_down(data + lo, 0, end);                                               \
+          }                                                                                     \
+          return;                                                                               \
+        }                                                                                       \
+        if (left >= __BASE_SORT_INSERTION_THRESHOLD) {                                          \
+          name##__swap(&data[lo], &data[lo + left / 4]);                                        \
+          name##__swap(&data[pivot - 1], &data[pivot - left / 4]);                              \
+        }                                                                                       \
+        if (right >= __BASE_SORT_INSERTION_THRESHOLD) {                                         \
+          name##__swap(&data[pivot + 1], &data[pivot + 1 + right / 4]);                         \
+          name##__swap(&data[hi - 1], &data[hi - right / 4]);                                   \
+        }                                                                                       \
+      } else if (!swapped) {                                                                    \
+        if (name##__insertion(data, lo, pivot, __BASE_SORT_PARTIAL_LIMIT) &&                    \
+            name##__insertion(data, pivot + 1, hi, __BASE_SORT_PARTIAL_LIMIT)) {                \
+          return;                                                                               \
+        }                                                                                       \
+      }                                                                                         \
+      if (left < right) {                                                                       \
+        name##__loop(data, lo, pivot, bad_allowed);                                             \
+        lo = pivot + 1;                                                                         \
+      } else {                                                                                  \
+        name##__loop(data, pivot + 1, hi, bad_allowed);                                         \
+        hi = pivot;                                                                             \
+      }                                                                                         \
+    }                                                                                           \
+    name##__insertion(data, lo, hi, SIZE_MAX);                                                  \
+  }                                                                                             \
+  MAYBE_UNUSED static void name(type *data, size_t length) {                                    \
+    if (length < 2) return;                                                                     \
+    size_t depth = 0;                                                                           \
+    for (size_t n = length; n > 1; n >>= 1) depth++;                                            \
+    name##__loop(data, 0, length, depth);                                                       \
+  }                                                                                             \
+  MAYBE_UNUSED static void name(type *data, size_t length)
+#define VecSortTyped(vector, name) name((vector).data, (vector).length)
+
+/* LSD radix sorts on primitive keys, byte passes every key agrees on are skipped. Uses a
+   scratch buffer as big as the vector, floats order as -NaN < -Inf < ... < -0 < +0 < ... < +NaN */
+#define VecRadixSortU32(vector) __base_radix_sort_u32((vector).data, (vector).length)
+#define VecRadixSortU64(vector) __base_radix_sort_u64((vector).data, (vector).length)
+#define VecRadixSortF32(vector) __base_radix_sort_f32((vector).data, (vector).length)
+void __base_radix_sort_u32(uint32_t *data, size_t length);
+void __base_radix_sort_u64(uint64_t *data, size_t length);
+void __base_radix_sort_f32(float32_t *data, size_t length);
+
+/* Vector that keeps its first `inlineCount` elements inside the struct and only allocates past
+   that, `heap` stays NULL until then. Use the SmallVec* macros, elements are at SmallVecData() */
+#define SMALLVEC_TYPE(typeName, valueType, inlineCount) \
+  typedef struct {                                      \
+    valueType *heap;                                    \
+    size_t length;                                      \
+    size_t capacity;                                    \
+    valueType inline_data[inlineCount];                 \
+  } typeName
+
+#define SmallVecData(vector) ((vector).heap ? (vector).heap : (vector).inline_data)
+#define SmallVecCapacity(vector) ((vector).heap ? (vector).capacity : ARR_LEN((vector).inline_data))
+
+#define SmallVecPushWith(vector, value, allocator)                                                                                                     \
+  do {                                                                                                                                                 \
+    if ((vector).length >= SmallVecCapacity(vector)) {                                                                                                 \
+      __base_smallvec_grow((allocator), (void **)&(vector).heap, (vector).inline_data, (vector).length, &(vector).capacity, sizeof(*(vector).heap), __BASE_CALLER); \
+    }                                                                                                                                                  \
+    SmallVecData(vector)[(vector).length++] = (value);                                                                                                 \
+  } while (0)
+#define SmallVecPush(vector, value) SmallVecPushWith(vector, value, (Allocator){0})
+void __base_smallvec_grow(Allocator allocator, void **heap, const void *inline_data, size_t length, size_t *capacity, size_t element_size, const char *file, uint32_t line);
+
+#define SmallVecPop(vector) ((__typeof__(*(vector).heap) *)__base_vec_pop(SmallVecData(vector), &(vector).length, sizeof(*(vector).heap)))
+
+#define SmallVecAt(vector, index) (*(__typeof__(*(vector).heap) *)__base_smallvec_at(SmallVecData(vector), (vector).length, (index), sizeof(*(vector).heap)))
+void *__base_smallvec_at(void *data, size_t length, size_t index, size_t element_size);
+
+#define SmallVecForEach(vector, it) for (__typeof__(*(vector).heap) *(it) = SmallVecData(vector); (it) < SmallVecData(vector) + (vector).length; (it)++)
+
+#define SmallVecFreeWith(vector, allocator) __base_vec_free_with((allocator), (void **)&(vector).heap, &(vector).length, &(vector).capacity, sizeof(*(vector).heap))
+#define SmallVecFree(vector) SmallVecFreeWith(vector, (Allocator){0})
+
+/*   }}} --- Deque Definitions --- {{{   */
+/* Ring buffer with O(1) push and pop on both ends, use it over VecShift/VecUnshift for queues.
+   `capacity` is 0 or a power of two and element `i` lives at `data[(head + i) & (capacity - 1)]` */
+#define DEQUE_TYPE(typeName, valueType) \
+  typedef struct {                      \
+    valueType *data;                    \
+    size_t head;                        \
+    size_t length;                      \
+    size_t capacity;                    \
+  } typeName
+
+#define DequePushBack(deque, value)                                                                                         \
+  do {                                                                                                                      \
+    if ((deque).length == (deque).capacity) {                                                                               \
+      __base_deque_grow((void **)&(deque).data, (deque).head, (deque).length, &(deque).capacity, sizeof(*(deque).data), __BASE_CALLER); \
+    }                                                                                                                       \
+    (deque).data[((deque).head + (deque).length) & ((deque).capacity - 1)] = (value);                                      \
+    (deque).length++;                                                                                                       \
+  } while (0)
+
+#define DequePushFront(deque, value)                                                                                        \
+  do {                                                                                                                      \
+    if ((deque).length == (deque).capacity) {                                                                               \
+      __base_deque_grow((void **)&(deque).data, (deque).head, (deque).length, &(deque).capacity, sizeof(*(deque).data), __BASE_CALLER); \
+    }                                                                                                                       \
+    (deque).head = ((deque).head - 1) & ((deque).capacity - 1);                                                             \
+    (deque).data[(deque).head] = (value);                                                                                   \
+    (deque).length++;                                                                                                       \
+  } while (0)
+
+void __base_deque_grow(void **data, size_t head, size_t length, size_t *capacity, size_t element_size, const char *file, uint32_t line);
+
+/* Pops return the element by value, its slot stays valid until the next push */
+#define DequePopFront(deque) (*(__typeof__(*(deque).data) *)__base_deque_pop_front((deque).data, &(deque).head, &(deque).length, (deque).capacity, sizeof(*(deque).data)))
+void *__base_deque_pop_front(void *data, size_t *head, size_t *length, size_t capacity, size_t element_size);
+
+#define DequePopBack(deque) (*(__typeof__(*(deque).data) *)__base_deque_pop_back((deque).data, (deque).head, &(deque).length, (deque).capacity, sizeof(*(deque).data)))
+void *__base_deque_pop_back(void *data, size_t head, size_t *length, size_t capacity, size_t element_size);
+
+#define DequeAt(deque, index) (*(__typeof__(*(deque).data) *)__base_deque_at((deque).data, (deque).head, (deque).length, (deque).capacity, (index), sizeof(*(deque).data)))
+void *__base_deque_at(void *data, size_t head, size_t length, size_t capacity, size_t index, size_t element_size);
+
+#define DequeFree(deque) __base_deque_free((void **)&(deque).data, &(deque).head, &(deque).length, &(deque).capacity)
+void __base_deque_free(void **data, size_t *head, size_t *length, size_t *capacity);
+
+/*   }}} --- HashMap Definitions --- {{{   */
+/* wyhash style 64-bit hash, `seed` picks an independent hash function */
+uint64_t HashBytes(const void *data, size_t length, uint64_t seed);
+uint64_t StrHash(String string);
+
+/* Open addressing with one control byte per slot (empty, deleted or 7 bits of the hash),
+   lookups compare 16 control bytes at a time with SSE2/NEON. `String` keys hash and compare
+   their contents, every other key type is hashed and compared bytewise (zero struct padding).
+   `String` keys are stored by reference, the bytes they point to must outlive the map, copy
+   them first (`StrNew`, `StrIntern`) when they come from a temporary buffer.
+   Memory comes from `allocator`, leave it zeroed for the heap or set it before the first insert:
+     HASHMAP_TYPE(Symbols, String, int32_t);
+     Symbols symbols = {.allocator = ArenaAllocator(arena)}; */
+#define HASHMAP_TYPE(typeName, keyType, valueType) \
+  typedef struct {                                 \
+    uint8_t *ctrl;                                 \
+    keyType *keys;                                 \
+    valueType *values;                             \
+    size_t length;                                 \
+    size_t capacity;                               \
+    size_t growth_left;                            \
+    Allocator allocator;                           \
+  } typeName
+
+typedef struct {
+  uint8_t *ctrl;
+  void *keys;
+  void *values;
+  size_t length;
+  size_t capacity;
+  size_t growth_left;
+  Allocator allocator;
+} __HashMap;
+
+#if defined(C_STANDARD_C99)
+#  define __BASE_IS_STRING(expr) __builtin_types_compatible_p(__typeof__(expr), String)
+#else
+#  define __BASE_IS_STRING(expr) _Generic((expr), String: true, default: false)
+#endif
+#define __BASE_MAP_ARGS(map) (__HashMap *)&(map), sizeof(*(map).keys), sizeof(*(map).values), __BASE_IS_STRING(*(map).keys)
+#define __BASE_MAP_KEY(map, key) (const void *)(__typeof__(*(map).keys)[1]){key}
+
+/* Inserts or overwrites `key`, `value` is evaluated into a temporary before the map is touched */
+#define HashMapPut(map, key, value) \
+  __base_map_set(__BASE_MAP_ARGS(map), __BASE_MAP_KEY(map, key), (const void *)(__typeof__(*(map).values)[1]){value}, __BASE_CALLER)
+void *__base_map_put(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, const void *key, const char *file, uint32_t line);
+void __base_map_set(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, const void *key, const void *value, const char *file, uint32_t line);
+
+/* Pointer to the value of `key` or NULL, valid until the next insert */
+#define HashMapGet(map, key) ((__typeof__((map).values))__base_map_get(__BASE_MAP_ARGS(map), __BASE_MAP_KEY(map, key)))
+void *__base_map_get(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, const void *key);
+
+#define HashMapHas(map, key) (HashMapGet(map, key) != NULL)
+
+/* Pointer to the value of `key`, inserting it with a zeroed value when missing */
+#define HashMapEntry(map, key) ((__typeof__((map).values))__base_map_put(__BASE_MAP_ARGS(map), __BASE_MAP_KEY(map, key), __BASE_CALLER))
+
+/* Returns true if `key` was there */
+#define HashMapRemove(map, key) __base_map_remove(__BASE_MAP_ARGS(map), __BASE_MAP_KEY(map, key))
+bool __base_map_remove(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, const void *key);
+
+/* Makes room for `count` entries without growing again */
+#define HashMapReserve(map, count) __base_map_reserve(__BASE_MAP_ARGS(map), (count), __BASE_CALLER)
+void __base_map_reserve(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, size_t count, const char *file, uint32_t line);
+
+#define HashMapClear(map) __base_map_clear((__HashMap *)&(map))
+void __base_map_clear(__HashMap *map);
+
+#define HashMapFree(map) __base_map_free((__HashMap *)&(map), sizeof(*(map).keys), sizeof(*(map).values))
+void __base_map_free(__HashMap *map, size_t key_size, size_t value_size);
+
+/* Visits the index of every entry, read them through `(map).keys[it]` and `(map).values[it]` */
+#define HashMapForEach(map, it) for (size_t it = __base_map_next((map).ctrl, (map).capacity, 0); it < (map).capacity; it = __base_map_next((map).ctrl, (map).capacity, it + 1))
+size_t __base_map_next(const uint8_t *ctrl, size_t capacity, size_t index);
+
 /*   }}} --- Time and Platform Definitions --- {{{   */
 int64_t TimeNow(void);
 void WaitTime(int64_t ms);
@@ -310,6 +692,10 @@ typedef enum {
   FILE_IS_DIRECTORY,     // EISDIR
   FILE_READ_ONLY_FS,     // EROFS
   FILE_ALREADY_EXISTS,   // EEXIST
+
+  PARSE_INVALID,         // no number at the start of the string
+  PARSE_OVERFLOW,        // number does not fit the type, the result is clamped
+  PARSE_TRAILING_CHARS,  // number followed by other characters, the result holds the number
 } Error;
 
 #define RESULT_TYPE(result_name, result_type) \
@@ -327,35 +713,285 @@ static void _custom_assert(const char *expr, const char *file, unsigned line, co
 #define Unreachable(...) (void)((_custom_unreachable(__FILE__, __LINE__, __VA_ARGS__), 0))
 static void _custom_unreachable(const char *file, unsigned line, const char *format, ...) FORMAT_CHECK(3, 4);
 
+/*   }}} --- Thread Definitions --- {{{   */
+typedef void *(*ThreadFunc)(void *arg);
+
+#if defined(BASE_PLATFORM_WIN)
+typedef struct {
+  HANDLE handle;
+  struct __ThreadStart *start; // holds the return value until ThreadJoin
+} Thread;
+
+typedef SRWLOCK Mutex;
+#  define MUTEX_INIT SRWLOCK_INIT
+
+typedef CONDITION_VARIABLE CondVar;
+#else
+typedef struct {
+  pthread_t handle;
+} Thread;
+
+typedef pthread_mutex_t Mutex;
+#  define MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+
+typedef pthread_cond_t CondVar;
+#endif
+
+Thread ThreadCreate(ThreadFunc func, void *arg);
+void *ThreadJoin(Thread thread);
+size_t ThreadHardwareCount(void); // logical cores, at least 1
+
+void MutexInit(Mutex *mutex) PARAM_NON_NULL;
+void MutexLock(Mutex *mutex) PARAM_NON_NULL;
+void MutexUnlock(Mutex *mutex) PARAM_NON_NULL;
+void MutexDestroy(Mutex *mutex) PARAM_NON_NULL;
+
+void CondVarInit(CondVar *cond) PARAM_NON_NULL;
+void CondVarWait(CondVar *cond, Mutex *mutex) PARAM_NON_NULL; // `mutex` must be locked, may wake up spuriously
+void CondVarSignal(CondVar *cond) PARAM_NON_NULL;
+void CondVarBroadcast(CondVar *cond) PARAM_NON_NULL;
+void CondVarDestroy(CondVar *cond) PARAM_NON_NULL;
+
+/* Atomics on `size_t`, loads acquire, stores release and read-modify-writes are both */
+size_t AtomicLoad(volatile size_t *target) PARAM_NON_NULL;
+void AtomicStore(volatile size_t *target, size_t value) PARAM_NON_NULL;
+size_t AtomicFetchAdd(volatile size_t *target, size_t value) PARAM_NON_NULL; // returns the previous value
+bool AtomicCompareExchange(volatile size_t *target, size_t *expected, size_t desired) PARAM_NON_NULL;
+
+/* Fixed set of workers draining a FIFO of tasks, ThreadPoolWait blocks until every submitted
+   task finished so the pool can be reused in rounds */
+typedef void (*ThreadPoolFunc)(void *arg);
+
+typedef struct {
+  ThreadPoolFunc func;
+  void *arg;
+} __ThreadPoolTask;
+
+typedef struct {
+  Thread *threads;
+  size_t thread_count;
+  Mutex lock;
+  CondVar has_work;
+  CondVar idle;
+  __ThreadPoolTask *tasks; // queued tasks are `tasks[head..length)`
+  size_t head;
+  size_t length;
+  size_t capacity;
+  size_t pending; // queued plus running
+  bool stopping;
+} ThreadPool;
+
+ThreadPool *ThreadPoolCreate(size_t thread_count); // 0 means ThreadHardwareCount()
+void ThreadPoolSubmit(ThreadPool *pool, ThreadPoolFunc func, void *arg) PARAM_NON_NULL;
+void ThreadPoolWait(ThreadPool *pool) PARAM_NON_NULL;
+void ThreadPoolDestroy(ThreadPool *pool) PARAM_NON_NULL; // waits for queued tasks first
+
 /*   }}} --- Arena Definitions --- {{{   */
+#define DEFAULT_ALIGNMENT (2 * sizeof(void *))
+
 typedef struct __ArenaChunk {
   struct __ArenaChunk *next;
   size_t cap;
-  char buffer[];
+  size_t idle; // resets spent on the free list without being picked
+  ALIGNAS(DEFAULT_ALIGNMENT) char buffer[];
 } __ArenaChunk;
 
+#if !defined(C_STANDARD_C99)
+_Static_assert(sizeof(__ArenaChunk) % DEFAULT_ALIGNMENT == 0, "__ArenaChunk: header must keep `buffer` at DEFAULT_ALIGNMENT");
+#endif
+
 typedef struct {
   __ArenaChunk *current;
   size_t offset;
   __ArenaChunk *root;
-  size_t chunk_size;
+  size_t chunk_size; // commit granularity when `reserved != 0`
+  size_t reserved;   // size of the virtual range, 0 for malloc'd chunk arenas
+  size_t committed;  // bytes of the virtual range backed by memory (header included)
+  size_t high_water; // biggest `offset` reached since the last reset
+  size_t dirty;      // bytes of the buffer that may be non-zero, committed pages past it are still zeroed
+
+  __ArenaChunk *free_list; // chunks unused since the last reset, sorted by `cap` smallest first
+  size_t retain_bytes;     // max bytes the free list keeps across resets
+  size_t max_idle_resets;  // resets a chunk may sit on the free list before it's freed, 0 = forever
+  bool pooled;             // chunks come from and go back to the global chunk pool
+
+#if defined(BASE_TRACK_ALLOC)
+  size_t allocated;   // bytes handed out since creation
+  size_t allocations; // calls since creation
+  size_t in_use;      // bytes handed out since the last reset/temp end
+  size_t peak;        // biggest `in_use` seen
+#endif
 } Arena;
 
-#define DEFAULT_ALIGNMENT (2 * sizeof(void *))
+#if !defined(ARENA_COMMIT_SIZE)
+#  define ARENA_COMMIT_SIZE (64 * 1024)
+#endif
 
 ALLOC_ATTR(2) void *ArenaAlloc(Arena *arena, size_t size);
 ALLOC_ATTR(2) char *ArenaAllocChars(Arena *arena, size_t count);
 ALLOC_ATTR2(2, 3) void *ArenaAllocAligned(Arena *arena, size_t size, size_t align);
 
+/* Same as above without zeroing, for buffers the caller is about to overwrite */
+ALLOC_ATTR(2) void *ArenaAllocNoZero(Arena *arena, size_t size);
+ALLOC_ATTR(2) char *ArenaAllocCharsNoZero(Arena *arena, size_t count);
+ALLOC_ATTR2(2, 3) void *ArenaPush(Arena *arena, size_t size, size_t align);
+
+/* Grows or shrinks `ptr` in place when it's the last allocation and the chunk has room,
+   otherwise copies it to a new allocation. Like realloc the grown part is not zeroed. */
+RETURNS_NON_NULL void *ArenaResize(Arena *arena, void *ptr, size_t old_size, size_t new_size);
+RETURNS_NON_NULL void *ArenaResizeAligned(Arena *arena, void *ptr, size_t old_size, size_t new_size, size_t align);
+
 void ArenaFree(Arena *arena) PARAM_NON_NULL;
 void ArenaReset(Arena *arena) PARAM_NON_NULL;
 
 Arena *ArenaCreate(size_t chunk_size) ATTR_MALLOC_DEALLOC(ArenaFree);
 
+/* Reserves `reserve_bytes` of address space once and commits it in `ARENA_COMMIT_SIZE`
+   steps as the offset grows, so the arena is a single contiguous block that never chains.
+   `ArenaReset` decommits the pages past the high-water mark of the last cycle. */
+Arena *ArenaCreateReserved(size_t reserve_bytes) ATTR_MALLOC_DEALLOC(ArenaFree);
+
+/* Chunk numbers are always filled, the allocation counters only with `BASE_TRACK_ALLOC` */
+typedef struct {
+  size_t chunks;      // chunks in use or on the free list, 1 for reserved arenas
+  size_t capacity;    // bytes of chunk memory (committed bytes for reserved arenas)
+  size_t allocated;   // bytes handed out since creation
+  size_t allocations; // calls since creation
+  size_t in_use;      // bytes handed out since the last reset
+  size_t peak;        // most bytes in use at once
+} ArenaStats;
+
+ArenaStats ArenaGetStats(Arena *arena) PARAM_NON_NULL;
+
+/* Marker of an arena position, `ArenaTempEnd` rolls the arena back to it and
+   everything allocated in between is reclaimed, what came before stays valid. */
+typedef struct {
+  Arena *arena;
+  __ArenaChunk *current;
+  size_t offset;
+#if defined(BASE_TRACK_ALLOC)
+  size_t in_use;
+#endif
+} ArenaTemp;
+
+/* Retention policy applied on `ArenaReset` to the chunks past the root, by default
+   everything is kept. Chunks idle for `max_idle_resets` resets are freed, then the
+   biggest ones until the free list holds at most `retain_bytes`. */
+void ArenaSetRetention(Arena *arena, size_t retain_bytes, size_t max_idle_resets) PARAM_NON_NULL;
+
+ArenaTemp ArenaTempBegin(Arena *arena) PARAM_NON_NULL;
+void ArenaTempEnd(ArenaTemp temp);
+
+/* Per-thread scratch arenas for temporary work, pass the arenas you are already
+   allocating into as `conflicts` so the scratch never aliases them:
+     ArenaTemp scratch = ScratchBegin(&arena, 1);
+     ...
+     ScratchEnd(scratch); */
+#if !defined(SCRATCH_ARENA_COUNT)
+#  define SCRATCH_ARENA_COUNT 2
+#endif
+
+ArenaTemp ScratchBegin(Arena **conflicts, size_t conflict_count);
+void ScratchEnd(ArenaTemp temp);
+void ScratchFree(void); // frees the calling thread's scratch arenas
+
+/* Arena that many threads can allocate from at once, a reserved range bumped with an
+   atomic fetch-add. Reset/Free must not race with allocations, reset zeroes the pages the
+   last cycle used and keeps them committed, the rest are decommitted. */
+typedef struct {
+  char *base;
+  size_t reserved;
+  volatile size_t offset;
+  volatile size_t committed;
+  Mutex commit_lock;
+} SharedArena;
+
+ALLOC_ATTR(2) void *SharedArenaAlloc(SharedArena *arena, size_t size);
+ALLOC_ATTR2(2, 3) void *SharedArenaAllocAligned(SharedArena *arena, size_t size, size_t align);
+
+void SharedArenaFree(SharedArena *arena) PARAM_NON_NULL;
+void SharedArenaReset(SharedArena *arena) PARAM_NON_NULL;
+
+SharedArena *SharedArenaCreate(size_t reserve_bytes) ATTR_MALLOC_DEALLOC(SharedArenaFree);
+
+/* Arena owned by the calling thread whose chunks come from a global pool, chunks go
+   back to the pool when trimmed by `ArenaReset` or on `ThreadArenaRelease`. The pool holds
+   at most `ARENA_POOL_MAX_CHUNKS`, chunks returned past that are freed. */
+#if !defined(ARENA_POOL_CHUNK_SIZE)
+#  define ARENA_POOL_CHUNK_SIZE (64 * 1024)
+#endif
+#if !defined(ARENA_POOL_MAX_CHUNKS)
+#  define ARENA_POOL_MAX_CHUNKS 64
+#endif
+
+Arena *ThreadArena(void);
+void ThreadArenaRelease(void);
+void ThreadArenaPoolTrim(size_t keep_chunks); // frees pooled chunks until `keep_chunks` are left, 0 empties the pool
+
+/*   }}} --- Pool Definitions --- {{{   */
+/* Fixed-size object allocator, objects are carved out of slabs taken from an arena
+   and freed ones are kept in an intrusive free list, alloc and free are O(1). */
+typedef struct {
+  Arena *arena;
+  void *free_list;
+  char *slab;
+  size_t slab_left;  // objects not yet carved out of `slab`
+  size_t elem_size;  // rounded up to hold the free list link and keep `align`
+  size_t align;
+  size_t slab_count; // objects per slab
+} Pool;
+
+#if !defined(POOL_SLAB_SIZE)
+#  define POOL_SLAB_SIZE (64 * 1024)
+#endif
+
+RETURNS_NON_NULL void *PoolAlloc(Pool *pool) PARAM_NON_NULL;
+void PoolFree(Pool *pool, void *ptr) PARAM_NON_NULL;
+void PoolReset(Pool *pool) PARAM_NON_NULL;
+void PoolDestroy(Pool *pool) PARAM_NON_NULL;
+
+Pool *PoolCreate(size_t elem_size, size_t align) ATTR_MALLOC_DEALLOC(PoolDestroy);
+
 /*   }}} --- Memory Allocation Definitions --- {{{   */
 void *Realloc(void *block, size_t size) RETURNS_NON_NULL;
 void *Malloc(size_t size) RETURNS_NON_NULL;
-void Free(void *address) PARAM_NON_NULL;
+void Free(void *address); // NULL is a no-op, like free
+
+/* Define `BASE_TRACK_ALLOC` to count every Malloc/Realloc/Free, bucket them per call
+   site and print the sites still holding memory at exit. Growth inside container macros
+   (VecPush, DequePushBack, HashMapPut, ...) is bucketed at the macro's caller. Tracked blocks
+   carry a small header, so memory from Malloc/Realloc must only be released with Free. */
+typedef struct {
+  size_t mallocs;
+  size_t reallocs;
+  size_t frees;
+  size_t bytes_allocated; // total requested by Malloc/Realloc
+  size_t live_bytes;
+  size_t live_blocks;
+  size_t peak_live_bytes;
+} AllocStats;
+
+AllocStats GetAllocStats(void); // zeroed without `BASE_TRACK_ALLOC`
+void AllocReport(void);         // logs every call site and its counters
+
+#if defined(BASE_TRACK_ALLOC)
+#  if !defined(ALLOC_TRACK_MAX_SITES)
+#    define ALLOC_TRACK_MAX_SITES 1024
+#  endif
+
+#  define Malloc(size) __base_malloc_at((size), __BASE_CALLER)
+#  define Realloc(block, size) __base_realloc_at((block), (size), __BASE_CALLER)
+#  define AllocatorAlloc(allocator, size, align) __base_allocator_alloc_at((allocator), (size), (align), __BASE_CALLER)
+#  define AllocatorResize(allocator, ptr, old_size, new_size, align) __base_allocator_resize_at((allocator), (ptr), (old_size), (new_size), (align), __BASE_CALLER)
+#endif
+
+// Same as Malloc/Realloc recorded at `file:line`, the call site is ignored without `BASE_TRACK_ALLOC`
+void *__base_malloc_at(size_t size, const char *file, uint32_t line) RETURNS_NON_NULL;
+void *__base_realloc_at(void *block, size_t size, const char *file, uint32_t line) RETURNS_NON_NULL;
+
+Allocator HeapAllocator(void);
+Allocator ArenaAllocator(Arena *arena) PARAM_NON_NULL;  // free is a no-op, memory goes away with the arena
+Allocator PoolAllocator(Pool *pool) PARAM_NON_NULL;     // sizes up to `pool->elem_size`
 
 /*   }}} --- String and Macros Definitions --- {{{   */
 #define TYPE_INIT(type) (type)
@@ -372,36 +1008,113 @@ VEC_TYPE(StringVector, String);
 void SetMaxStrSize(size_t size);
 String StrNew(Arena *arena, char *str);
 String StrNewSize(Arena *arena, char *str, size_t len); // len without null terminator
+String StrFromU64(Arena *arena, uint64_t value);
+String StrFromI64(Arena *arena, int64_t value);
+
+/* Number parsing on String views (no null terminator needed, no whitespace skipped). Integers are
+   [+-]digits, doubles are [+-]digits[.digits][(e|E)[+-]digits], inf, infinity or nan */
+RESULT_TYPE(ParseI64Result, int64_t);
+RESULT_TYPE(ParseU64Result, uint64_t);
+RESULT_TYPE(ParseF64Result, float64_t);
+WARN_UNUSED ParseI64Result StrParseI64(String string);
+WARN_UNUSED ParseU64Result StrParseU64(String string);
+WARN_UNUSED ParseF64Result StrParseF64(String string);
 
 void StrCopy(String *destination, String source);
 bool StrEq(String string1, String string2);
 String StrConcat(Arena *arena, String string1, String string2);
 StringVector StrSplit(Arena *arena, String string, String delimiter);
 
+/* Zero-copy splitting, tokens are views into `string` (not null terminated) and nothing is allocated:
+     StrSplitIter it = StrSplitBegin(text, S("\n"));
+     for (String line; StrSplitNext(&it, &line);) { ... }
+   Tokens match StrSplit's: empty tokens between adjacent delimiters, none after a trailing one */
+typedef struct {
+  String rest; // not split yet
+  String delimiter;
+} StrSplitIter;
+
+StrSplitIter StrSplitBegin(String string, String delimiter);
+bool StrSplitNext(StrSplitIter *it, String *token) PARAM_NON_NULL;
+StringVector StrSplitView(String string, String delimiter); // vector of views, free it with VecFree
+
+/* ASCII only (locale independent), 16/32 bytes per step with SSE2/AVX2/NEON and 8 with SWAR */
 void StrToUpper(String string1);
 void StrToLower(String string1);
+bool StrEqIgnoreCase(String string1, String string2);
+uint64_t StrHashIgnoreCase(String string); // same hash for strings StrEqIgnoreCase considers equal
 
 bool StrIsNull(String string);
 bool StrIsEmpty(String string);
 void StrTrim(String *string);
+String StrTrimView(String string); // sub-view without the surrounding whitespace, nothing is moved
 
 String StrSlice(Arena *arena, String str, size_t start, ssize_t end);
 bool StrIncludes(String source, String subStr);
 
+/* Byte offset of the first/last match or -1, an empty `needle` matches at 0/length */
+ssize_t StrFind(String haystack, String needle);
+ssize_t StrFindLast(String haystack, String needle);
+ssize_t StrFindChar(String string, char c);
+
+typedef struct __SBChunk {
+  struct __SBChunk *next;
+  size_t length;
+  size_t capacity;
+  char data[];
+} __SBChunk;
+
 typedef struct {
   size_t capacity;
   String buffer;
-  Arena *arena_builder;
+  Allocator allocator;
+  Arena *arena_builder; // DEPRECATED: use `allocator`, set by the Arena constructors and still honored when `allocator` is zeroed
+  /* Chunked mode (chunk_size != 0): appends go into a list of fixed blocks that are never moved, so
+     growing never copies. `buffer` stays empty, use SBLength, SBToString and SBWriteToFile instead */
+  __SBChunk *head;
+  __SBChunk *tail;
+  size_t chunk_size;
+  size_t total_length;
 } StringBuilder;
 
+#ifndef SB_CHUNK_SIZE
+#  define SB_CHUNK_SIZE (64 * 1024)
+#endif
+
 StringBuilder SBCreate(Arena *arena);
 StringBuilder SBReserve(Arena *arena, size_t capacity);
+StringBuilder SBCreateWith(Allocator allocator);
+StringBuilder SBReserveWith(Allocator allocator, size_t capacity);
+StringBuilder SBCreateChunked(Arena *arena);
+StringBuilder SBCreateChunkedWith(Allocator allocator, size_t chunk_size); // 0 uses SB_CHUNK_SIZE
+void SBFree(StringBuilder *builder); // only needed when the allocator is not an arena
 void SBAdd(StringBuilder *builder, String string);
+void SBAddU64(StringBuilder *builder, uint64_t value); // written in place, no temporary copy
+void SBAddI64(StringBuilder *builder, int64_t value);
+size_t SBLength(StringBuilder *builder);
+String SBToString(Arena *arena, StringBuilder *builder); // flat builders return their buffer, chunked ones are joined into `arena`
 void SBAddF(StringBuilder *builder, char *fmt, ...);
 void SBAddFormatV(StringBuilder *builder, char *fmt, va_list args);
 
 #define SBAddS(builder, string) SBAdd(builder, S(string))
 
+/* Stores each distinct string once and hands out a small id for it, so equal strings always get
+   equal ids and comparing them is an integer compare. Ids start at 1, 0 is never handed out */
+typedef uint32_t InternId;
+HASHMAP_TYPE(__InternIds, String, InternId);
+
+typedef struct {
+  Arena *arena;        // interned bytes, null terminated
+  __InternIds ids;     // keys point into `arena`
+  StringVector strings; // `strings.data[id - 1]`
+} InternTable;
+
+InternTable *InternTableCreate(void);
+void InternTableFree(InternTable *table) PARAM_NON_NULL;
+InternId StrIntern(InternTable *table, String string) PARAM_NON_NULL;
+InternId StrInternFind(InternTable *table, String string) PARAM_NON_NULL; // 0 when `string` was never interned
+String InternGet(InternTable *table, InternId id) PARAM_NON_NULL;
+
 /*   }}} --- Random Definitions --- {{{   */
 void RandomInit(void);
 uint64_t RandomGetSeed(void);
@@ -432,9 +1145,11 @@ WARN_UNUSED FileStatsResult FileStats(String path);
 
 RESULT_TYPE(FileReadResult, String);
 WARN_UNUSED FileReadResult FileRead(Arena *arena, String path, size_t file_size);
+WARN_UNUSED FileReadResult FileReadWith(Allocator allocator, String path, size_t file_size);
 
 WARN_UNUSED Error FileWrite(String path, String data);
 WARN_UNUSED Error FileAdd(String path, String data);
+WARN_UNUSED Error SBWriteToFile(StringBuilder *builder, String path); // writes chunks as they are, without joining them
 WARN_UNUSED Error FileDelete(String path);
 WARN_UNUSED Error FileRename(String oldPath, String newPath);
 WARN_UNUSED Error FileCopy(String sourcePath, String destPath);
@@ -543,177 +1258,969 @@ WARN_UNUSED errno_t memcpy_s(void *dest, size_t destSize, const void *src, size_
 }
 #  endif
 
-/*   }}} --- Vector Implementations --- {{{   */
-int32_t __base_vec_partition(void **data, size_t element_size, CompareFunc compare, int32_t low, int32_t high) {
-  void *pivot = (char *)(*data) + (high * element_size);
-  int32_t i = low - 1;
-  for (int32_t j = low; j < high; j++) {
-    void *current = (char *)(*data) + (j * element_size);
-    if (compare(current, pivot) < 0) {
-      i++;
-      void *temp = (char *)(*data) + (i * element_size);
-      char *temp_buffer = Malloc(element_size);
-      memcpy(temp_buffer, temp, element_size);
-      memcpy(temp, current, element_size);
-      memcpy(current, temp_buffer, element_size);
-      Free(temp_buffer);
-    }
-  }
-  i++;
-  void *temp = (char *)(*data) + (i * element_size);
-  char *temp_buffer = Malloc(element_size);
-  memcpy(temp_buffer, temp, element_size);
-  memcpy(temp, pivot, element_size);
-  memcpy(pivot, temp_buffer, element_size);
-  Free(temp_buffer);
-  return i;
-}
-
-void __base_vec_quicksort(void **data, size_t element_size, CompareFunc compare, int32_t low, int32_t high) {
-  if (low < high) {
-    int32_t pi = __base_vec_partition(data, element_size, compare, low, high);
-    __base_vec_quicksort(data, element_size, compare, low, pi - 1);
-    __base_vec_quicksort(data, element_size, compare, pi + 1, high);
-  }
-}
-
-void __base_vec_push(void **data, size_t *length, size_t *capacity, size_t element_size, void *value) {
-  // WARNING: Vector must always be initialized to zero `Vector vector = {0}`
-  Assert(*length <= *capacity, "VecPush: Possible memory corruption or vector not initialized, `Vector vector = {0}`");
-  Assert(!(*length > 0 && *data == NULL), "VecPush: Possible memory corruption, data should be NULL only if length == 0");
+// Both expect `value != 0`
+static inline uint32_t __base_ctz64(uint64_t value) {
+#  if defined(BASE_COMPILER_GCC) || defined(BASE_COMPILER_CLANG)
+  return (uint32_t)__builtin_ctzll(value);
+#  elif defined(BASE_COMPILER_MSVC) && defined(_WIN64)
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return (uint32_t)index;
+#  else
+  uint32_t count = 0;
+  while ((value & 1) == 0) {
+    value >>= 1;
+    count++;
+  }
+  return count;
+#  endif
+}
 
-  if (*length >= *capacity) {
-    if (*capacity == 0) *capacity = 128;
-    else *capacity *= 2;
+#  if defined(BASE_SIMD_NEON)
+// NEON has no movemask, every byte of a 0x00/0xFF compare result becomes one bit 4 apart
+static inline uint64_t __base_neon_movemask(uint8x16_t matches) {
+  uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ULL;
+}
+#  endif
 
-    *data = Realloc(*data, *capacity * element_size);
+static inline uint32_t __base_clz64(uint64_t value) {
+#  if defined(BASE_COMPILER_GCC) || defined(BASE_COMPILER_CLANG)
+  return (uint32_t)__builtin_clzll(value);
+#  elif defined(BASE_COMPILER_MSVC) && defined(_WIN64)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return 63 - (uint32_t)index;
+#  else
+  uint32_t count = 0;
+  while ((value & (1ULL << 63)) == 0) {
+    value <<= 1;
+    count++;
   }
+  return count;
+#  endif
+}
 
-  void *address = (char *)(*data) + (*length * element_size);
-  memcpy(address, value, element_size);
+/*   }}} --- Vector Implementations --- {{{   */
+#  define __BASE_SORT_AT(i) (base + (i) * size)
+
+static void __base_sort_swap(char *a, char *b, size_t size) {
+  char tmp[64];
+  while (size > 0) {
+    size_t n = Min(size, sizeof(tmp));
+    memcpy(tmp, a, n);
+    memcpy(a, b, n);
+    memcpy(b, tmp, n);
+    a += n;
+    b += n;
+    size -= n;
+  }
+}
 
-  (*length)++;
+static void __base_sort_insertion(char *base, size_t lo, size_t hi, size_t size, CompareFunc compare) {
+  for (size_t i = lo + 1; i < hi; i++) {
+    for (size_t j = i; j > lo && compare(__BASE_SORT_AT(j - 1), __BASE_SORT_AT(j)) > 0; j--) {
+      __base_sort_swap(__BASE_SORT_AT(j - 1), __BASE_SORT_AT(j), size);
+    }
+  }
 }
 
-void *__base_vec_pop(void *data, size_t *length, size_t element_size) {
-  Assert(*length > 0, "VecPop: Cannot pop from empty vector");
-  (*length)--;
-  return (char *)data + (*length * element_size);
+// Insertion sort that gives up once too many elements moved, true if [lo, hi) ended sorted
+static bool __base_sort_partial_insertion(char *base, size_t lo, size_t hi, size_t size, CompareFunc compare) {
+  size_t moved = 0;
+  for (size_t i = lo + 1; i < hi; i++) {
+    size_t j = i;
+    for (; j > lo && compare(__BASE_SORT_AT(j - 1), __BASE_SORT_AT(j)) > 0; j--) {
+      __base_sort_swap(__BASE_SORT_AT(j - 1), __BASE_SORT_AT(j), size);
+    }
+
+    moved += i - j;
+    if (moved > __BASE_SORT_PARTIAL_LIMIT) return false;
+  }
+  return true;
 }
 
-void __base_vec_shift(void **data, size_t *length, size_t element_size) {
-  Assert(*length != 0, "VecShift: Length should at least be >= 1");
-  memmove(*data, (char *)(*data) + element_size, ((*length) - 1) * element_size);
-  (*length)--;
+static void __base_sort_sift_down(char *base, size_t root, size_t length, size_t size, CompareFunc compare) {
+  size_t child;
+  while ((child = 2 * root + 1) < length) {
+    if (child + 1 < length && compare(__BASE_SORT_AT(child), __BASE_SORT_AT(child + 1)) < 0) child++;
+    if (compare(__BASE_SORT_AT(root), __BASE_SORT_AT(child)) >= 0) return;
+    __base_sort_swap(__BASE_SORT_AT(root), __BASE_SORT_AT(child), size);
+    root = child;
+  }
 }
 
-void __base_vec_unshift(void **data, size_t *length, size_t *capacity, size_t element_size, const void *value) {
-  if (*length >= *capacity) {
-    if (*capacity == 0) *capacity = 2;
-    else *capacity *= 2;
-    *data = Realloc(*data, *capacity * element_size);
+static void __base_sort_heap(char *base, size_t length, size_t size, CompareFunc compare) {
+  for (size_t i = length / 2; i-- > 0;) {
+    __base_sort_sift_down(base, i, length, size, compare);
   }
 
-  if (*length > 0) {
-    memmove((char *)(*data) + element_size, *data, (*length) * element_size);
+  for (size_t end = length - 1; end > 0; end--) {
+    __base_sort_swap(base, __BASE_SORT_AT(end), size);
+    __base_sort_sift_down(base, 0, end, size, compare);
   }
+}
 
-  memcpy(*data, value, element_size);
-  (*length)++;
+// Order the elements at `a`, `b` and `c`
+static void __base_sort3(char *base, size_t a, size_t b, size_t c, size_t size, CompareFunc compare) {
+  if (compare(__BASE_SORT_AT(b), __BASE_SORT_AT(a)) < 0) __base_sort_swap(__BASE_SORT_AT(a), __BASE_SORT_AT(b), size);
+  if (compare(__BASE_SORT_AT(c), __BASE_SORT_AT(b)) < 0) {
+    __base_sort_swap(__BASE_SORT_AT(b), __BASE_SORT_AT(c), size);
+    if (compare(__BASE_SORT_AT(b), __BASE_SORT_AT(a)) < 0) __base_sort_swap(__BASE_SORT_AT(a), __BASE_SORT_AT(b), size);
+  }
 }
 
-void __base_vec_insert(void **data, size_t *length, size_t *capacity, size_t element_size, void *value, size_t index) {
-  Assert(index <= *length, "VecInsert: Index out of bounds for insertion");
+static void __base_sort_loop(char *base, size_t lo, size_t hi, size_t size, CompareFunc compare, size_t bad_allowed) {
+  while (hi - lo > __BASE_SORT_INSERTION_THRESHOLD) {
+    size_t length = hi - lo;
+    size_t mid = lo + length / 2;
+    if (length > __BASE_SORT_NINTHER_THRESHOLD) {
+      __base_sort3(base, lo, mid, hi - 1, size, compare);
+      __base_sort3(base, lo + 1, mid - 1, hi - 2, size, compare);
+      __base_sort3(base, lo + 2, mid + 1, hi - 3, size, compare);
+      __base_sort3(base, mid - 1, mid, mid + 1, size, compare);
+    } else {
+      __base_sort3(base, lo, mid, hi - 1, size, compare);
+    }
+    __base_sort_swap(__BASE_SORT_AT(lo), __BASE_SORT_AT(mid), size);
+
+    // Elements equal to the pivot stop both scans, so runs of duplicates split evenly
+    size_t i = lo, j = hi;
+    bool swapped = false;
+    for (;;) {
+      while (compare(__BASE_SORT_AT(++i), __BASE_SORT_AT(lo)) < 0) {
+        if (i == hi - 1) break;
+      }
+      while (compare(__BASE_SORT_AT(lo), __BASE_SORT_AT(--j)) < 0) {
+        if (j == lo) break;
+      }
+      if (i >= j) break;
+      __base_sort_swap(__BASE_SORT_AT(i), __BASE_SORT_AT(j), size);
+      swapped = true;
+    }
+    __base_sort_swap(__BASE_SORT_AT(lo), __BASE_SORT_AT(j), size);
+
+    size_t pivot = j;
+    size_t left = pivot - lo;
+    size_t right = hi - pivot - 1;
+    if (left < length / 8 || right < length / 8) { // unbalanced, shuffle a few elements around
+      if (--bad_allowed == 0) {
+        __base_sort_heap(__BASE_SORT_AT(lo), length, size, compare);
+        return;
+      }
 
-  if (*length >= *capacity) {
-    if (*capacity == 0) *capacity = 2;
-    else *capacity *= 2;
-    *data = Realloc(*data, *capacity * element_size);
-  }
+      if (left >= __BASE_SORT_INSERTION_THRESHOLD) {
+        __base_sort_swap(__BASE_SORT_AT(lo), __BASE_SORT_AT(lo + left / 4), size);
+        __base_sort_swap(__BASE_SORT_AT(pivot - 1), __BASE_SORT_AT(pivot - left / 4), size);
+      }
+      if (right >= __BASE_SORT_INSERTION_THRESHOLD) {
+        __base_sort_swap(__BASE_SORT_AT(pivot + 1), __BASE_SORT_AT(pivot + 1 + right / 4), size);
+        __base_sort_swap(__BASE_SORT_AT(hi - 1), __BASE_SORT_AT(hi - right / 4), size);
+      }
+    } else if (!swapped) { // likely already sorted, try to finish cheaply
+      if (__base_sort_partial_insertion(base, lo, pivot, size, compare) &&
+          __base_sort_partial_insertion(base, pivot + 1, hi, size, compare)) {
+        return;
+      }
+    }
 
-  if (index < *length) {
-    memmove((char *)(*data) + ((index + 1) * element_size), (char *)(*data) + (index * element_size), (*length - index) * element_size);
+    // Recurse into the smaller side and loop on the bigger one, keeps the stack at O(log n)
+    if (left < right) {
+      __base_sort_loop(base, lo, pivot, size, compare, bad_allowed);
+      lo = pivot + 1;
+    } else {
+      __base_sort_loop(base, pivot + 1, hi, size, compare, bad_allowed);
+      hi = pivot;
+    }
   }
 
-  memcpy((char *)(*data) + (index * element_size), value, element_size);
-  (*length)++;
+  __base_sort_insertion(base, lo, hi, size, compare);
 }
 
-void *__base_vec_at(void **data, size_t *length, size_t index, size_t elementSize) {
-  Assert(index < *length, "VecAt: Index out of bounds");
-  void *address = (char *)(*data) + (index * elementSize);
-  return address;
+void __base_vec_sort(void *data, size_t length, size_t element_size, CompareFunc compare) {
+  if (length < 2) return;
+
+  size_t depth = 0;
+  for (size_t n = length; n > 1; n >>= 1) {
+    depth++;
+  }
+  __base_sort_loop((char *)data, 0, length, element_size, compare, depth);
 }
 
-void __base_vec_free(void **data, size_t *length, size_t *capacity) {
-  free(*data);
-  *data = NULL;
-  *length = 0;
-  *capacity = 0;
+#  define __BASE_PARALLEL_SORT_MIN 16384 // below this spawning workers costs more than it saves
+
+// Merges sorted `a` and `b` into `out`, ties take from `a` first so it's stable
+static void __base_sort_merge(const char *a, size_t a_len, const char *b, size_t b_len, char *out, size_t size, CompareFunc compare) {
+  const char *a_end = a + a_len * size;
+  const char *b_end = b + b_len * size;
+  while (a < a_end && b < b_end) {
+    if (compare(b, a) < 0) {
+      memcpy(out, b, size);
+      b += size;
+    } else {
+      memcpy(out, a, size);
+      a += size;
+    }
+    out += size;
+  }
+
+  memcpy(out, a, (size_t)(a_end - a));
+  out += a_end - a;
+  memcpy(out, b, (size_t)(b_end - b));
 }
 
-/*   }}} --- Time and Platforms Implementations --- {{{   */
-int64_t TimeNow(void) {
-#  if defined(BASE_PLATFORM_WIN)
-  FILETIME ft;
-  GetSystemTimeAsFileTime(&ft);
-  LARGE_INTEGER li;
-  li.LowPart = ft.dwLowDateTime;
-  li.HighPart = ft.dwHighDateTime;
-  // Convert Windows FILETIME (100-nanosecond intervals since January 1, 1601)
-  // to UNIX timestamp in milliseconds
-  int64_t current_time = (li.QuadPart - 116444736000000000LL) / 10000;
-#  else
-  struct timespec ts;
-  clock_gettime(CLOCK_REALTIME, &ts);
-  int64_t current_time = (ts.tv_sec * 1000LL) + (ts.tv_nsec / 1000000LL);
-#  endif
-  Assert(current_time != -1, "TimeNow: current_time should never be -1");
-  return current_time;
+// Bottom-up merge sort over insertion sorted runs, `scratch` must fit `length` elements
+static void __base_sort_stable(char *base, char *scratch, size_t length, size_t size, CompareFunc compare) {
+  const size_t run = __BASE_SORT_INSERTION_THRESHOLD;
+  for (size_t lo = 0; lo < length; lo += run) {
+    __base_sort_insertion(base, lo, Min(lo + run, length), size, compare);
+  }
+
+  char *src = base, *dst = scratch;
+  for (size_t width = run; width < length; width *= 2) {
+    for (size_t lo = 0; lo < length; lo += 2 * width) {
+      size_t mid = Min(lo + width, length);
+      size_t hi = Min(lo + 2 * width, length);
+      __base_sort_merge(src + lo * size, mid - lo, src + mid * size, hi - mid, dst + lo * size, size, compare);
+    }
+
+    char *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  if (src != base) memcpy(base, src, length * size);
 }
 
-void WaitTime(int64_t ms) {
-#  if defined(BASE_PLATFORM_WIN)
-  sleep(ms);
-#  else
-  struct timespec ts;
-  ts.tv_sec = ms / 1000;
-  ts.tv_nsec = (ms % 1000) * 1000000;
-  nanosleep(&ts, NULL);
-#  endif
+// First index of `base[0..length)` not less than `key`, or with `upper` the first greater than it
+static size_t __base_sort_bound(const char *base, size_t length, const char *key, size_t size, CompareFunc compare, bool upper) {
+  size_t lo = 0, hi = length;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    int32_t order = compare(base + mid * size, key);
+    if (order < 0 || (upper && order == 0)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
 }
 
-OS GetOS(void) {
-#  if defined(BASE_PLATFORM_WIN)
-  return OS_WINDOWS;
-#  elif defined(BASE_PLATFORM_ANDROID)
-  return OS_ANDROID;
-#  elif defined(BASE_PLATFORM_LINUX)
-  return OS_LINUX;
-#  elif defined(BASE_PLATFORM_MACOS)
-  return OS_MACOS;
-#  elif defined(BASE_PLATFORM_FREEBSD)
-  return OS_FREEBSD;
-#  elif defined(BASE_PLATFORM_EMSCRIPTEN)
-  return OS_EMSCRIPTEN;
-#  else
-#    error "base.h: Unsupported platform"
-#  endif
+typedef struct {
+  char *data;
+  char *scratch;
+  size_t length;
+  size_t size;
+  CompareFunc compare;
+  bool stable;
+} __SortSliceTask;
+
+typedef struct {
+  const char *a;
+  size_t a_len;
+  const char *b;
+  size_t b_len;
+  char *out;
+  size_t size;
+  CompareFunc compare;
+} __SortMergeTask;
+
+static void __base_sort_slice_task(void *arg) {
+  __SortSliceTask *task = arg;
+  if (task->stable) {
+    __base_sort_stable(task->data, task->scratch, task->length, task->size, task->compare);
+  } else {
+    __base_vec_sort(task->data, task->length, task->size, task->compare);
+  }
 }
 
-char *GetOSStr(void) {
-#  if defined(BASE_PLATFORM_WIN)
-  return "windows";
-#  elif defined(BASE_PLATFORM_ANDROID)
-  return "android";
-#  elif defined(BASE_PLATFORM_LINUX)
-  return "linux";
+static void __base_sort_merge_task(void *arg) {
+  __SortMergeTask *task = arg;
+  __base_sort_merge(task->a, task->a_len, task->b, task->b_len, task->out, task->size, task->compare);
+}
+
+void __base_vec_sort_parallel(void *data, size_t length, size_t element_size, CompareFunc compare, size_t threads, bool stable) {
+  if (threads == 0) threads = ThreadHardwareCount();
+  if (threads <= 1 || length < __BASE_PARALLEL_SORT_MIN) {
+    if (!stable) {
+      __base_vec_sort(data, length, element_size, compare);
+    } else if (length > 1) {
+      char *scratch = Malloc(length * element_size);
+      __base_sort_stable(data, scratch, length, element_size, compare);
+      Free(scratch);
+    }
+    return;
+  }
+
+  const size_t size = element_size;
+  char *scratch = Malloc(length * size);
+  size_t *bounds = Malloc((threads + 1) * sizeof(size_t)); // run `i` is `[bounds[i], bounds[i + 1])`
+  __SortSliceTask *slices = Malloc(threads * sizeof(__SortSliceTask));
+  __SortMergeTask *merges = Malloc((threads + 1) * sizeof(__SortMergeTask));
+  ThreadPool *pool = ThreadPoolCreate(threads);
+
+  for (size_t i = 0; i <= threads; i++) {
+    bounds[i] = length / threads * i + Min(i, length % threads);
+  }
+  for (size_t i = 0; i < threads; i++) {
+    slices[i] = (__SortSliceTask){
+        .data = (char *)data + bounds[i] * size,
+        .scratch = scratch + bounds[i] * size,
+        .length = bounds[i + 1] - bounds[i],
+        .size = size,
+        .compare = compare,
+        .stable = stable,
+    };
+    ThreadPoolSubmit(pool, __base_sort_slice_task, &slices[i]);
+  }
+  ThreadPoolWait(pool);
+
+  char *src = data, *dst = scratch;
+  for (size_t runs = threads; runs > 1; runs = (runs + 1) / 2) {
+    size_t pairs = runs / 2;
+    size_t parts = Max(threads / pairs, 1);
+    size_t task_count = 0;
+
+    for (size_t pair = 0; pair < pairs; pair++) {
+      size_t lo = bounds[2 * pair], mid = bounds[2 * pair + 1], hi = bounds[2 * pair + 2];
+      const char *a = src + lo * size, *b = src + mid * size;
+      size_t a_len = mid - lo, b_len = hi - mid;
+
+      // Cut the longer run evenly and binary search the matching cut in the other one
+      size_t a_prev = 0, b_prev = 0;
+      for (size_t part = 1; part <= parts; part++) {
+        size_t a_cut = a_len, b_cut = b_len;
+        if (part < parts && a_len >= b_len) {
+          a_cut = a_len * part / parts;
+          b_cut = __base_sort_bound(b, b_len, a + a_cut * size, size, compare, false);
+        } else if (part < parts) {
+          b_cut = b_len * part / parts;
+          a_cut = __base_sort_bound(a, a_len, b + b_cut * size, size, compare, true);
+        }
+
+        merges[task_count++] = (__SortMergeTask){
+            .a = a + a_prev * size,
+            .a_len = a_cut - a_prev,
+            .b = b + b_prev * size,
+            .b_len = b_cut - b_prev,
+            .out = dst + (lo + a_prev + b_prev) * size,
+            .size = size,
+            .compare = compare,
+        };
+        a_prev = a_cut;
+        b_prev = b_cut;
+      }
+    }
+
+    if (runs % 2 == 1) { // odd run out moves over as is
+      size_t lo = bounds[runs - 1], hi = bounds[runs];
+      merges[task_count++] = (__SortMergeTask){.a = src + lo * size, .a_len = hi - lo, .b = src + hi * size, .out = dst + lo * size, .size = size, .compare = compare};
+    }
+
+    for (size_t i = 0; i < task_count; i++) {
+      ThreadPoolSubmit(pool, __base_sort_merge_task, &merges[i]);
+    }
+    ThreadPoolWait(pool);
+
+    for (size_t i = 0; 2 * i < runs; i++) {
+      bounds[i] = bounds[2 * i];
+    }
+    bounds[(runs + 1) / 2] = length;
+
+    char *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  if (src != data) memcpy(data, src, length * size);
+
+  ThreadPoolDestroy(pool);
+  Free(merges);
+  Free(slices);
+  Free(bounds);
+  Free(scratch);
+}
+
+#  define __BASE_RADIX_THRESHOLD 256
+
+VEC_SORT_IMPL(__base_sort_u32, uint32_t, *a < *b);
+VEC_SORT_IMPL(__base_sort_u64, uint64_t, *a < *b);
+
+// One histogram per byte gathered in a single read, then a scatter pass per byte that varies
+#  define __BASE_RADIX_SORT(type, data, length)                                         \
+    do {                                                                                \
+      size_t counts[sizeof(type)][256] = {0};                                           \
+      for (size_t i = 0; i < (length); i++) {                                           \
+        for (size_t byte = 0; byte < sizeof(type); byte++) {                            \
+          counts[byte][((data)[i] >> (byte * 8)) & 0xFF]++;                             \
+        }                                                                               \
+      }                                                                                 \
+                                                                                        \
+      type *scratch = Malloc((length) * sizeof(type));                                  \
+      type *src = (data), *dst = scratch;                                               \
+      for (size_t byte = 0; byte < sizeof(type); byte++) {                              \
+        size_t *count = counts[byte];                                                   \
+        if (count[((data)[0] >> (byte * 8)) & 0xFF] == (length)) continue;              \
+                                                                                        \
+        size_t offset = 0;                                                              \
+        for (size_t digit = 0; digit < 256; digit++) {                                  \
+          size_t bucket = count[digit];                                                 \
+          count[digit] = offset;                                                        \
+          offset += bucket;                                                             \
+        }                                                                               \
+        for (size_t i = 0; i < (length); i++) {                                         \
+          dst[count[(src[i] >> (byte * 8)) & 0xFF]++] = src[i];                         \
+        }                                                                               \
+        type *tmp = src;                                                                \
+        src = dst;                                                                      \
+        dst = tmp;                                                                      \
+      }                                                                                 \
+                                                                                        \
+      if (src != (data)) memcpy((data), src, (length) * sizeof(type));                  \
+      Free(scratch);                                                                    \
+    } while (0)
+
+void __base_radix_sort_u32(uint32_t *data, size_t length) {
+  if (length < __BASE_RADIX_THRESHOLD) {
+    __base_sort_u32(data, length);
+    return;
+  }
+  __BASE_RADIX_SORT(uint32_t, data, length);
+}
+
+void __base_radix_sort_u64(uint64_t *data, size_t length) {
+  if (length < __BASE_RADIX_THRESHOLD) {
+    __base_sort_u64(data, length);
+    return;
+  }
+  __BASE_RADIX_SORT(uint64_t, data, length);
+}
+
+// Maps floats to keys that order as unsigned integers: flip every bit of negatives, only the sign of positives
+// Keys are mapped into their own uint32_t buffer, sorting the float storage through a uint32_t
+// pointer would break strict aliasing
+void __base_radix_sort_f32(float32_t *data, size_t length) {
+  if (length < 2) return;
+
+  uint32_t *keys = Malloc(length * sizeof(uint32_t));
+  memcpy(keys, data, length * sizeof(uint32_t));
+  for (size_t i = 0; i < length; i++) {
+    keys[i] ^= (keys[i] & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+  }
+
+  __base_radix_sort_u32(keys, length);
+
+  for (size_t i = 0; i < length; i++) {
+    keys[i] ^= (keys[i] & 0x80000000u) ? 0x80000000u : 0xFFFFFFFFu;
+  }
+  memcpy(data, keys, length * sizeof(uint32_t));
+  Free(keys);
+}
+
+// Makes room for at least `needed` elements following the growth policy
+void __base_vec_grow(Allocator allocator, void **data, size_t length, size_t *capacity, size_t needed, size_t element_size, const char *file, uint32_t line) {
+  // WARNING: Vector must always be initialized to zero `Vector vector = {0}`
+  Assert(length <= *capacity, "VecPush: Possible memory corruption or vector not initialized, `Vector vector = {0}`");
+  Assert(!(length > 0 && *data == NULL), "VecPush: Possible memory corruption, data should be NULL only if length == 0");
+  if (needed <= *capacity) return;
+
+  size_t new_capacity = *capacity == 0 ? VEC_MIN_CAPACITY : __BASE_VEC_GROWTH(*capacity);
+  while (new_capacity < needed) {
+    new_capacity = __BASE_VEC_GROWTH(new_capacity);
+  }
+
+  *data = __base_allocator_resize_at(allocator, *data, *capacity * element_size, new_capacity * element_size, DEFAULT_ALIGNMENT, file, line);
+  *capacity = new_capacity;
+}
+
+void __base_vec_push_many(Allocator allocator, void **data, size_t *length, size_t *capacity, size_t element_size, const void *values, size_t count, const char *file, uint32_t line) {
+  Assert(*length <= *capacity, "VecPushMany: Possible memory corruption or vector not initialized, `Vector vector = {0}`");
+  if (count == 0) return;
+
+  // `values` inside the vector would dangle once it grows, keep its offset and rebase it after
+  uintptr_t start = (uintptr_t)*data, source = (uintptr_t)values;
+  bool aliased = *data != NULL && source >= start && source < start + *capacity * element_size;
+  size_t offset = aliased ? (size_t)(source - start) : 0;
+
+  __base_vec_grow(allocator, data, *length, capacity, *length + count, element_size, file, line);
+  if (aliased) values = (char *)(*data) + offset;
+  memmove((char *)(*data) + (*length * element_size), values, count * element_size);
+  *length += count;
+}
+
+void __base_vec_resize(Allocator allocator, void **data, size_t *length, size_t *capacity, size_t element_size, size_t new_length, const char *file, uint32_t line) {
+  if (new_length > *length) {
+    __base_vec_grow(allocator, data, *length, capacity, new_length, element_size, file, line);
+    memset((char *)(*data) + (*length * element_size), 0, (new_length - *length) * element_size);
+  }
+  *length = new_length;
+}
+
+void __base_vec_shrink_to_fit(Allocator allocator, void **data, size_t *length, size_t *capacity, size_t element_size, const char *file, uint32_t line) {
+  if (*length == *capacity) return;
+  if (*length == 0) {
+    __base_vec_free_with(allocator, data, length, capacity, element_size);
+    return;
+  }
+
+  *data = __base_allocator_resize_at(allocator, *data, *capacity * element_size, *length * element_size, DEFAULT_ALIGNMENT, file, line);
+  *capacity = *length;
+}
+
+void *__base_vec_pop(void *data, size_t *length, size_t element_size) {
+  Assert(*length > 0, "VecPop: Cannot pop from empty vector");
+  (*length)--;
+  return (char *)data + (*length * element_size);
+}
+
+void __base_vec_shift(void **data, size_t *length, size_t element_size) {
+  Assert(*length != 0, "VecShift: Length should at least be >= 1");
+  memmove(*data, (char *)(*data) + element_size, ((*length) - 1) * element_size);
+  (*length)--;
+}
+
+void __base_vec_unshift(void **data, size_t *length, size_t *capacity, size_t element_size, const void *value, const char *file, uint32_t line) {
+  __base_vec_grow((Allocator){0}, data, *length, capacity, *length + 1, element_size, file, line);
+
+  if (*length > 0) {
+    memmove((char *)(*data) + element_size, *data, (*length) * element_size);
+  }
+
+  memcpy(*data, value, element_size);
+  (*length)++;
+}
+
+void __base_vec_insert(void **data, size_t *length, size_t *capacity, size_t element_size, void *value, size_t index, const char *file, uint32_t line) {
+  Assert(index <= *length, "VecInsert: Index out of bounds for insertion");
+  __base_vec_grow((Allocator){0}, data, *length, capacity, *length + 1, element_size, file, line);
+
+  if (index < *length) {
+    memmove((char *)(*data) + ((index + 1) * element_size), (char *)(*data) + (index * element_size), (*length - index) * element_size);
+  }
+
+  memcpy((char *)(*data) + (index * element_size), value, element_size);
+  (*length)++;
+}
+
+void *__base_vec_at(void **data, size_t *length, size_t index, size_t elementSize) {
+  Assert(index < *length, "VecAt: Index out of bounds");
+  void *address = (char *)(*data) + (index * elementSize);
+  return address;
+}
+
+void __base_vec_free(void **data, size_t *length, size_t *capacity) {
+  if (*data) Free(*data);
+  *data = NULL;
+  *length = 0;
+  *capacity = 0;
+}
+
+void __base_vec_free_with(Allocator allocator, void **data, size_t *length, size_t *capacity, size_t element_size) {
+  AllocatorFree(allocator, *data, *capacity * element_size);
+  *data = NULL;
+  *length = 0;
+  *capacity = 0;
+}
+
+void __base_smallvec_grow(Allocator allocator, void **heap, const void *inline_data, size_t length, size_t *capacity, size_t element_size, const char *file, uint32_t line) {
+  if (*heap != NULL) {
+    __base_vec_grow(allocator, heap, length, capacity, length + 1, element_size, file, line);
+    return;
+  }
+
+  // Spilling: the inline elements move to the first allocation
+  *capacity = __BASE_VEC_GROWTH(length);
+  *heap = __base_allocator_alloc_at(allocator, *capacity * element_size, DEFAULT_ALIGNMENT, file, line);
+  memcpy(*heap, inline_data, length * element_size);
+}
+
+void *__base_smallvec_at(void *data, size_t length, size_t index, size_t element_size) {
+  Assert(index < length, "SmallVecAt: Index out of bounds");
+  return (char *)data + (index * element_size);
+}
+
+/*   }}} --- Deque Implementations --- {{{   */
+void __base_deque_grow(void **data, size_t head, size_t length, size_t *capacity, size_t element_size, const char *file, uint32_t line) {
+  size_t old_capacity = *capacity;
+  *capacity = old_capacity == 0 ? 16 : old_capacity * 2;
+  *data = __base_realloc_at(*data, *capacity * element_size, file, line);
+
+  // Elements that wrapped around the old end move right after it, the new half is still free
+  if (old_capacity > 0 && head + length > old_capacity) {
+    size_t wrapped = head + length - old_capacity;
+    memcpy((char *)(*data) + old_capacity * element_size, *data, wrapped * element_size);
+  }
+}
+
+void *__base_deque_pop_front(void *data, size_t *head, size_t *length, size_t capacity, size_t element_size) {
+  Assert(*length > 0, "DequePopFront: Cannot pop from empty deque");
+  void *address = (char *)data + (*head * element_size);
+  *head = (*head + 1) & (capacity - 1);
+  (*length)--;
+  return address;
+}
+
+void *__base_deque_pop_back(void *data, size_t head, size_t *length, size_t capacity, size_t element_size) {
+  Assert(*length > 0, "DequePopBack: Cannot pop from empty deque");
+  (*length)--;
+  return (char *)data + (((head + *length) & (capacity - 1)) * element_size);
+}
+
+void *__base_deque_at(void *data, size_t head, size_t length, size_t capacity, size_t index, size_t element_size) {
+  Assert(index < length, "DequeAt: Index out of bounds");
+  return (char *)data + (((head + index) & (capacity - 1)) * element_size);
+}
+
+void __base_deque_free(void **data, size_t *head, size_t *length, size_t *capacity) {
+  __base_vec_free(data, length, capacity);
+  *head = 0;
+}
+
+/*   }}} --- HashMap Implementations --- {{{   */
+#  define __BASE_HASH_SECRET0 0xa0761d6478bd642fULL
+#  define __BASE_HASH_SECRET1 0xe7037ed1a0b428dbULL
+
+// 64x64 -> 128 bit multiply folded back to 64 bits
+static inline uint64_t __base_hash_mix(uint64_t a, uint64_t b) {
+#  if defined(__SIZEOF_INT128__)
+  __uint128_t product = (__uint128_t)a * b;
+  return (uint64_t)product ^ (uint64_t)(product >> 64);
+#  else
+  uint64_t a_lo = (uint32_t)a, a_hi = a >> 32, b_lo = (uint32_t)b, b_hi = b >> 32;
+  uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+  uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+  uint64_t hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+  uint64_t lo = (cross << 32) | (uint32_t)lo_lo;
+  return lo ^ hi;
+#  endif
+}
+
+static inline uint64_t __base_read64(const uint8_t *p) {
+  uint64_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static inline uint64_t __base_read32(const uint8_t *p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint64_t HashBytes(const void *data, size_t length, uint64_t seed) {
+  const uint8_t *p = data;
+  uint64_t a = 0, b = 0;
+  seed ^= __BASE_HASH_SECRET0;
+
+  if (length <= 16) {
+    if (length >= 4) {
+      size_t middle = (length >> 3) << 2;
+      a = (__base_read32(p) << 32) | __base_read32(p + middle);
+      b = (__base_read32(p + length - 4) << 32) | __base_read32(p + length - 4 - middle);
+    } else if (length > 0) {
+      a = ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+    }
+  } else {
+    size_t left = length;
+    while (left > 16) {
+      seed = __base_hash_mix(__base_read64(p) ^ __BASE_HASH_SECRET1, __base_read64(p + 8) ^ seed);
+      p += 16;
+      left -= 16;
+    }
+    a = __base_read64(p + left - 16);
+    b = __base_read64(p + left - 8);
+  }
+
+  return __base_hash_mix(__BASE_HASH_SECRET1 ^ length, __base_hash_mix(a ^ __BASE_HASH_SECRET1, b ^ seed));
+}
+
+uint64_t StrHash(String string) {
+  return HashBytes(string.data, string.length, 0);
+}
+
+#  define __BASE_MAP_GROUP 16
+#  define __BASE_MAP_EMPTY 0x80
+#  define __BASE_MAP_DELETED 0xFE
+
+/* Group matches are bitmasks with one bit per control byte, `__BASE_MAP_LANE_SHIFT` bits apart
+   (NEON has no movemask so every byte gets a nibble) */
+#  if defined(BASE_SIMD_SSE2)
+#    define __BASE_MAP_LANE_SHIFT 0
+
+static inline uint64_t __base_map_match(const uint8_t *group, uint8_t byte) {
+  __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+  return (uint64_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)byte)));
+}
+
+static inline uint64_t __base_map_match_free(const uint8_t *group) { // empty or deleted, both have the top bit
+  return (uint64_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
+#  elif defined(BASE_SIMD_NEON)
+#    define __BASE_MAP_LANE_SHIFT 2
+
+static inline uint64_t __base_map_match(const uint8_t *group, uint8_t byte) {
+  return __base_neon_movemask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(byte)));
+}
+
+static inline uint64_t __base_map_match_free(const uint8_t *group) {
+  return __base_neon_movemask(vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(group)), vdupq_n_s8(0)));
+}
+#  else
+#    define __BASE_MAP_LANE_SHIFT 0
+
+static inline uint64_t __base_map_match(const uint8_t *group, uint8_t byte) {
+  uint64_t mask = 0;
+  for (uint32_t i = 0; i < __BASE_MAP_GROUP; i++) {
+    mask |= (uint64_t)(group[i] == byte) << i;
+  }
+  return mask;
+}
+
+static inline uint64_t __base_map_match_free(const uint8_t *group) {
+  uint64_t mask = 0;
+  for (uint32_t i = 0; i < __BASE_MAP_GROUP; i++) {
+    mask |= (uint64_t)(group[i] >> 7) << i;
+  }
+  return mask;
+}
+#  endif
+
+static inline uint32_t __base_map_first(uint64_t mask) {
+  return __base_ctz64(mask) >> __BASE_MAP_LANE_SHIFT;
+}
+
+static inline uint64_t __base_map_hash(const void *key, size_t key_size, bool string_keys) {
+  if (string_keys) return StrHash(*(const String *)key);
+  return HashBytes(key, key_size, 0);
+}
+
+static inline bool __base_map_key_eq(const void *a, const void *b, size_t key_size, bool string_keys) {
+  if (string_keys) return StrEq(*(const String *)a, *(const String *)b);
+  return memcmp(a, b, key_size) == 0;
+}
+
+// Control bytes are followed by a copy of the first group so probes near the end can read a full group
+static inline void __base_map_set_ctrl(__HashMap *map, size_t index, uint8_t value) {
+  map->ctrl[index] = value;
+  if (index < __BASE_MAP_GROUP) map->ctrl[map->capacity + index] = value;
+}
+
+static size_t __base_map_block_size(size_t capacity, size_t key_size, size_t value_size, size_t *keys_offset, size_t *values_offset) {
+  *keys_offset = (capacity + __BASE_MAP_GROUP + DEFAULT_ALIGNMENT - 1) & ~(size_t)(DEFAULT_ALIGNMENT - 1);
+  *values_offset = (*keys_offset + capacity * key_size + DEFAULT_ALIGNMENT - 1) & ~(size_t)(DEFAULT_ALIGNMENT - 1);
+  return *values_offset + capacity * value_size;
+}
+
+// First empty or deleted slot on the probe sequence of `hash`
+static size_t __base_map_find_free(const __HashMap *map, uint64_t hash) {
+  size_t mask = map->capacity - 1;
+  size_t pos = (size_t)(hash >> 7) & mask;
+  for (size_t stride = __BASE_MAP_GROUP;; stride += __BASE_MAP_GROUP) {
+    uint64_t slots = __base_map_match_free(map->ctrl + pos);
+    if (slots) return (pos + __base_map_first(slots)) & mask;
+    pos = (pos + stride) & mask;
+  }
+}
+
+static size_t __base_map_find(const __HashMap *map, size_t key_size, bool string_keys, const void *key, uint64_t hash) {
+  if (map->capacity == 0) return SIZE_MAX;
+
+  size_t mask = map->capacity - 1;
+  size_t pos = (size_t)(hash >> 7) & mask;
+  uint8_t tag = hash & 0x7F;
+  for (size_t stride = __BASE_MAP_GROUP;; stride += __BASE_MAP_GROUP) {
+    const uint8_t *group = map->ctrl + pos;
+    for (uint64_t matches = __base_map_match(group, tag); matches; matches &= matches - 1) {
+      size_t index = (pos + __base_map_first(matches)) & mask;
+      if (__base_map_key_eq((char *)map->keys + index * key_size, key, key_size, string_keys)) return index;
+    }
+
+    if (__base_map_match(group, __BASE_MAP_EMPTY)) return SIZE_MAX;
+    pos = (pos + stride) & mask;
+  }
+}
+
+// Moves every entry into a fresh table of `capacity` slots, tombstones are dropped on the way
+static void __base_map_rehash(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, size_t capacity, const char *file, uint32_t line) {
+  size_t keys_offset, values_offset;
+  size_t block_size = __base_map_block_size(capacity, key_size, value_size, &keys_offset, &values_offset);
+  char *block = __base_allocator_alloc_at(map->allocator, block_size, DEFAULT_ALIGNMENT, file, line);
+
+  __HashMap old = *map;
+  map->ctrl = (uint8_t *)block;
+  map->keys = block + keys_offset;
+  map->values = block + values_offset;
+  map->capacity = capacity;
+  map->growth_left = capacity - capacity / 8 - old.length;
+  memset(map->ctrl, __BASE_MAP_EMPTY, capacity + __BASE_MAP_GROUP);
+
+  for (size_t i = 0; i < old.capacity; i++) {
+    if (old.ctrl[i] & 0x80) continue;
+
+    const char *key = (char *)old.keys + i * key_size;
+    uint64_t hash = __base_map_hash(key, key_size, string_keys);
+    size_t index = __base_map_find_free(map, hash);
+    __base_map_set_ctrl(map, index, hash & 0x7F);
+    memcpy((char *)map->keys + index * key_size, key, key_size);
+    memcpy((char *)map->values + index * value_size, (char *)old.values + i * value_size, value_size);
+  }
+
+  if (old.ctrl) {
+    size_t old_block_size = __base_map_block_size(old.capacity, key_size, value_size, &keys_offset, &values_offset);
+    AllocatorFree(map->allocator, old.ctrl, old_block_size);
+  }
+}
+
+void *__base_map_put(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, const void *key, const char *file, uint32_t line) {
+  uint64_t hash = __base_map_hash(key, key_size, string_keys);
+  size_t index = __base_map_find(map, key_size, string_keys, key, hash);
+  if (index != SIZE_MAX) return (char *)map->values + index * value_size;
+
+  if (map->growth_left == 0) {
+    // Mostly tombstones: same size rehash cleans them up, otherwise double
+    size_t capacity = map->capacity == 0 ? __BASE_MAP_GROUP : map->capacity;
+    if (map->length >= capacity / 2) capacity *= 2;
+    __base_map_rehash(map, key_size, value_size, string_keys, capacity, file, line);
+  }
+
+  index = __base_map_find_free(map, hash);
+  if (map->ctrl[index] == __BASE_MAP_EMPTY) map->growth_left--;
+  __base_map_set_ctrl(map, index, hash & 0x7F);
+  map->length++;
+
+  memcpy((char *)map->keys + index * key_size, key, key_size);
+  void *value = (char *)map->values + index * value_size;
+  memset(value, 0, value_size);
+  return value;
+}
+
+void __base_map_set(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, const void *key, const void *value, const char *file, uint32_t line) {
+  memcpy(__base_map_put(map, key_size, value_size, string_keys, key, file, line), value, value_size);
+}
+
+void *__base_map_get(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, const void *key) {
+  size_t index = __base_map_find(map, key_size, string_keys, key, __base_map_hash(key, key_size, string_keys));
+  if (index == SIZE_MAX) return NULL;
+  return (char *)map->values + index * value_size;
+}
+
+bool __base_map_remove(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, const void *key) {
+  (void)value_size;
+  size_t index = __base_map_find(map, key_size, string_keys, key, __base_map_hash(key, key_size, string_keys));
+  if (index == SIZE_MAX) return false;
+
+  /* A probe only walks past a slot when its whole group was full, so if the empties around the
+     slot are less than a group apart no lookup ever went through it and it can go back to empty */
+  size_t mask = map->capacity - 1;
+  uint64_t empty_before = __base_map_match(map->ctrl + ((index - __BASE_MAP_GROUP) & mask), __BASE_MAP_EMPTY);
+  uint64_t empty_after = __base_map_match(map->ctrl + index, __BASE_MAP_EMPTY);
+  bool never_full = false;
+  if (empty_before && empty_after) {
+    uint32_t lanes_before = (__base_clz64(empty_before) - (64 - (__BASE_MAP_GROUP << __BASE_MAP_LANE_SHIFT))) >> __BASE_MAP_LANE_SHIFT;
+    never_full = lanes_before + __base_map_first(empty_after) < __BASE_MAP_GROUP;
+  }
+
+  __base_map_set_ctrl(map, index, never_full ? __BASE_MAP_EMPTY : __BASE_MAP_DELETED);
+  if (never_full) map->growth_left++;
+  map->length--;
+  return true;
+}
+
+void __base_map_reserve(__HashMap *map, size_t key_size, size_t value_size, bool string_keys, size_t count, const char *file, uint32_t line) {
+  if (count <= map->length + map->growth_left) return;
+
+  size_t capacity = __BASE_MAP_GROUP;
+  while (capacity - capacity / 8 < count) {
+    capacity *= 2;
+  }
+  __base_map_rehash(map, key_size, value_size, string_keys, capacity, file, line);
+}
+
+void __base_map_clear(__HashMap *map) {
+  if (map->capacity == 0) return;
+  memset(map->ctrl, __BASE_MAP_EMPTY, map->capacity + __BASE_MAP_GROUP);
+  map->length = 0;
+  map->growth_left = map->capacity - map->capacity / 8;
+}
+
+void __base_map_free(__HashMap *map, size_t key_size, size_t value_size) {
+  if (map->ctrl) {
+    size_t keys_offset, values_offset;
+    AllocatorFree(map->allocator, map->ctrl, __base_map_block_size(map->capacity, key_size, value_size, &keys_offset, &values_offset));
+  }
+  *map = (__HashMap){.allocator = map->allocator};
+}
+
+size_t __base_map_next(const uint8_t *ctrl, size_t capacity, size_t index) {
+  while (index < capacity && (ctrl[index] & 0x80)) {
+    index++;
+  }
+  return index;
+}
+
+/*   }}} --- Time and Platforms Implementations --- {{{   */
+int64_t TimeNow(void) {
+#  if defined(BASE_PLATFORM_WIN)
+  FILETIME ft;
+  GetSystemTimeAsFileTime(&ft);
+  LARGE_INTEGER li;
+  li.LowPart = ft.dwLowDateTime;
+  li.HighPart = ft.dwHighDateTime;
+  // Convert Windows FILETIME (100-nanosecond intervals since January 1, 1601)
+  // to UNIX timestamp in milliseconds
+  int64_t current_time = (li.QuadPart - 116444736000000000LL) / 10000;
+#  else
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  int64_t current_time = (ts.tv_sec * 1000LL) + (ts.tv_nsec / 1000000LL);
+#  endif
+  Assert(current_time != -1, "TimeNow: current_time should never be -1");
+  return current_time;
+}
+
+void WaitTime(int64_t ms) {
+#  if defined(BASE_PLATFORM_WIN)
+  sleep(ms);
+#  else
+  struct timespec ts;
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (ms % 1000) * 1000000;
+  nanosleep(&ts, NULL);
+#  endif
+}
+
+OS GetOS(void) {
+#  if defined(BASE_PLATFORM_WIN)
+  return OS_WINDOWS;
+#  elif defined(BASE_PLATFORM_ANDROID)
+  return OS_ANDROID;
+#  elif defined(BASE_PLATFORM_LINUX)
+  return OS_LINUX;
 #  elif defined(BASE_PLATFORM_MACOS)
-  return "macos";
+  return OS_MACOS;
 #  elif defined(BASE_PLATFORM_FREEBSD)
-  return "freebsd";
+  return OS_FREEBSD;
 #  elif defined(BASE_PLATFORM_EMSCRIPTEN)
-  return "emscripten";
+  return OS_EMSCRIPTEN;
+#  else
+#    error "base.h: Unsupported platform"
+#  endif
+}
+
+char *GetOSStr(void) {
+#  if defined(BASE_PLATFORM_WIN)
+  return "windows";
+#  elif defined(BASE_PLATFORM_ANDROID)
+  return "android";
+#  elif defined(BASE_PLATFORM_LINUX)
+  return "linux";
+#  elif defined(BASE_PLATFORM_MACOS)
+  return "macos";
+#  elif defined(BASE_PLATFORM_FREEBSD)
+  return "freebsd";
+#  elif defined(BASE_PLATFORM_EMSCRIPTEN)
+  return "emscripten";
 #  else
 #    error "base.h: Unsupported platform"
 #  endif
@@ -741,239 +2248,1386 @@ Arch GetArch(void) {
 #  endif
 }
 
-char *GetArchStr(void) {
-#  if defined(BASE_ARCH_X64)
-  return "x86_64";
-#  elif defined(BASE_ARCH_ARM64)
-  return "aarch64";
-#  elif defined(BASE_ARCH_X86)
-  return "x86";
-#  elif defined(BASE_ARCH_ARM32)
-  return "arm";
-#  elif defined(BASE_ARCH_RISCV64)
-  return "riscv64";
-#  elif defined(BASE_ARCH_PPC64)
-  return "ppc64";
-#  elif defined(BASE_ARCH_S390X)
-  return "s390x";
-#  elif defined(BASE_ARCH_WASM32)
-  return "wasm32";
-#  else
-#    error "base.h: Unsupported arch"
+char *GetArchStr(void) {
+#  if defined(BASE_ARCH_X64)
+  return "x86_64";
+#  elif defined(BASE_ARCH_ARM64)
+  return "aarch64";
+#  elif defined(BASE_ARCH_X86)
+  return "x86";
+#  elif defined(BASE_ARCH_ARM32)
+  return "arm";
+#  elif defined(BASE_ARCH_RISCV64)
+  return "riscv64";
+#  elif defined(BASE_ARCH_PPC64)
+  return "ppc64";
+#  elif defined(BASE_ARCH_S390X)
+  return "s390x";
+#  elif defined(BASE_ARCH_WASM32)
+  return "wasm32";
+#  else
+#    error "base.h: Unsupported arch"
+#  endif
+}
+
+CompilerFamily GetCompilerFamily(void) {
+#  if defined(BASE_COMPILER_CLANG)
+  return COMPILER_CLANG;
+#  elif defined(BASE_COMPILER_GCC)
+  return COMPILER_GCC;
+#  elif defined(BASE_COMPILER_MSVC)
+  return COMPILER_MSVC;
+#  elif defined(BASE_COMPILER_TCC)
+  return COMPILER_TCC;
+#  else
+#    error "base.h: Unsupported compiler"
+#  endif
+}
+
+char *GetCompilerStr(void) {
+#  if defined(BASE_COMPILER_CLANG)
+#    if defined(BASE_COMPILER_FILC)
+  return "filc";
+#    else
+  return "clang";
+#    endif
+#  elif defined(BASE_COMPILER_GCC)
+  return "gcc";
+#  elif defined(BASE_COMPILER_MSVC)
+  return "cl.exe";
+#  elif defined(BASE_COMPILER_TCC)
+  return "tcc";
+#  else
+#    error "base.h: Unsupported compiler"
+#  endif
+}
+
+/* --- Error Implementation --- */
+#  if defined(BASE_PLATFORM_WIN)
+Error ErrnoMatch(errno_t err) {
+  switch (err) {
+    case ERROR_FILE_NOT_FOUND:
+    case ERROR_PATH_NOT_FOUND:      return FILE_NOT_FOUND;
+    case ERROR_NOT_ENOUGH_MEMORY:
+    case ERROR_OUTOFMEMORY:         return FILE_NO_MEMORY;
+    case ERROR_ACCESS_DENIED:       return FILE_ACCESS_DENIED;
+    case ERROR_DISK_FULL:           return FILE_DISK_FULL;
+    case ERROR_ALREADY_EXISTS:      return FILE_ALREADY_EXISTS;
+    case ERROR_TOO_MANY_OPEN_FILES: return FILE_TOO_MANY_OPEN;
+    case ERROR_BUFFER_OVERFLOW:     return FILE_PATH_TOO_LONG;
+    case ERROR_DIRECTORY:           return FILE_IS_DIRECTORY;
+    case ERROR_WRITE_PROTECT:       return FILE_READ_ONLY_FS;
+  }
+  return FILE_ACCESS_DENIED;
+}
+#else
+Error ErrnoMatch(errno_t err) {
+  if (err == SUCCESS) return SUCCESS;
+  switch (err) {
+    case ENOENT:       return FILE_NOT_FOUND;
+    case ENOMEM:       return FILE_NO_MEMORY;
+    case ENOSPC:       return FILE_DISK_FULL;
+    case EMFILE:       return FILE_TOO_MANY_OPEN;
+    case ENFILE:       return FILE_TOO_MANY_OPEN;
+    case EACCES:       return FILE_ACCESS_DENIED;
+    case ENAMETOOLONG: return FILE_PATH_TOO_LONG;
+    case EISDIR:       return FILE_IS_DIRECTORY;
+    case EROFS:        return FILE_READ_ONLY_FS;
+    case EEXIST:       return FILE_ALREADY_EXISTS;
+  }
+  return FILE_ACCESS_DENIED;
+}
+#endif
+
+String ErrToStr(errno_t err) {
+  switch (err) {
+    case FILE_ACCESS_DENIED:  return S("File access denied");
+    case FILE_NOT_FOUND:      return S("File not found");
+    case FILE_NO_MEMORY:      return S("File no memory");
+    case FILE_DISK_FULL:      return S("File disk full");
+    case FILE_READ_FAILED:    return S("File read Failed");
+    case FILE_WRITE_FAILED:   return S("File write failed");
+    case FILE_TOO_MANY_OPEN:  return S("File too many open");
+    case FILE_PATH_TOO_LONG:  return S("File path too long");
+    case FILE_IS_DIRECTORY:   return S("File is directory");
+    case FILE_READ_ONLY_FS:   return S("File read only FS");
+    case FILE_ALREADY_EXISTS: return S("File already exists");
+
+    case PARSE_INVALID:        return S("Parse invalid number");
+    case PARSE_OVERFLOW:       return S("Parse number overflow");
+    case PARSE_TRAILING_CHARS: return S("Parse trailing characters");
+  }
+
+  return S("");
+}
+
+static void _custom_assert(const char *expr, const char *file, unsigned line, const char *format, ...) {
+  printf("%sAssertion failed: %s, file %s, line %u %s\n", _RED, expr, file, line, _RESET);
+
+  if (format) {
+    va_list args;
+    va_start(args, format);
+    logErrorV(format, args);
+    va_end(args);
+  }
+
+  fflush(stdout);
+  abort();
+}
+
+static void _custom_unreachable(const char *file, unsigned line, const char *format, ...) {
+  printf("%sReached Unreachable code at file %s, line %u %s\n", _RED, file, line, _RESET);
+
+  if (format) {
+    va_list args;
+    va_start(args, format);
+    logErrorV(format, args);
+    va_end(args);
+  }
+
+  fflush(stdout);
+  abort();
+}
+
+/*   }}} --- Thread Implementations --- {{{   */
+#  if defined(BASE_PLATFORM_WIN)
+typedef struct __ThreadStart {
+  ThreadFunc func;
+  void *arg;
+  void *result;
+} __ThreadStart;
+
+static DWORD WINAPI __base_thread_entry(LPVOID param) {
+  __ThreadStart *start = (__ThreadStart *)param;
+  start->result = start->func(start->arg);
+  return 0;
+}
+
+Thread ThreadCreate(ThreadFunc func, void *arg) {
+  __ThreadStart *start = Malloc(sizeof(__ThreadStart));
+  *start = (__ThreadStart){.func = func, .arg = arg};
+
+  Thread thread = {.handle = CreateThread(NULL, 0, __base_thread_entry, start, 0, NULL), .start = start};
+  Assert(thread.handle != NULL, "ThreadCreate: failed, err: %lu", GetLastError());
+  return thread;
+}
+
+void *ThreadJoin(Thread thread) {
+  WaitForSingleObject(thread.handle, INFINITE);
+  CloseHandle(thread.handle);
+  void *result = thread.start->result;
+  Free(thread.start);
+  return result;
+}
+
+void MutexInit(Mutex *mutex) {
+  InitializeSRWLock(mutex);
+}
+
+void MutexLock(Mutex *mutex) {
+  AcquireSRWLockExclusive(mutex);
+}
+
+void MutexUnlock(Mutex *mutex) {
+  ReleaseSRWLockExclusive(mutex);
+}
+
+void MutexDestroy(Mutex *mutex) {
+  (void)mutex;
+}
+
+size_t ThreadHardwareCount(void) {
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+}
+
+void CondVarInit(CondVar *cond) {
+  InitializeConditionVariable(cond);
+}
+
+void CondVarWait(CondVar *cond, Mutex *mutex) {
+  SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+}
+
+void CondVarSignal(CondVar *cond) {
+  WakeConditionVariable(cond);
+}
+
+void CondVarBroadcast(CondVar *cond) {
+  WakeAllConditionVariable(cond);
+}
+
+void CondVarDestroy(CondVar *cond) {
+  (void)cond;
+}
+#  else
+Thread ThreadCreate(ThreadFunc func, void *arg) {
+  Thread thread = {0};
+  errno_t err = pthread_create(&thread.handle, NULL, func, arg);
+  Assert(err == SUCCESS, "ThreadCreate: failed, err: %d", err);
+  return thread;
+}
+
+void *ThreadJoin(Thread thread) {
+  void *result = NULL;
+  errno_t err = pthread_join(thread.handle, &result);
+  Assert(err == SUCCESS, "ThreadJoin: failed, err: %d", err);
+  return result;
+}
+
+void MutexInit(Mutex *mutex) {
+  errno_t err = pthread_mutex_init(mutex, NULL);
+  Assert(err == SUCCESS, "MutexInit: failed, err: %d", err);
+}
+
+void MutexLock(Mutex *mutex) {
+  pthread_mutex_lock(mutex);
+}
+
+void MutexUnlock(Mutex *mutex) {
+  pthread_mutex_unlock(mutex);
+}
+
+void MutexDestroy(Mutex *mutex) {
+  pthread_mutex_destroy(mutex);
+}
+
+size_t ThreadHardwareCount(void) {
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (size_t)count : 1;
+}
+
+void CondVarInit(CondVar *cond) {
+  errno_t err = pthread_cond_init(cond, NULL);
+  Assert(err == SUCCESS, "CondVarInit: failed, err: %d", err);
+}
+
+void CondVarWait(CondVar *cond, Mutex *mutex) {
+  pthread_cond_wait(cond, mutex);
+}
+
+void CondVarSignal(CondVar *cond) {
+  pthread_cond_signal(cond);
+}
+
+void CondVarBroadcast(CondVar *cond) {
+  pthread_cond_broadcast(cond);
+}
+
+void CondVarDestroy(CondVar *cond) {
+  pthread_cond_destroy(cond);
+}
+#  endif
+
+static void *__base_thread_pool_worker(void *arg) {
+  ThreadPool *pool = arg;
+  MutexLock(&pool->lock);
+  for (;;) {
+    while (pool->head == pool->length && !pool->stopping) {
+      CondVarWait(&pool->has_work, &pool->lock);
+    }
+    if (pool->head == pool->length) break; // stopping and drained
+
+    __ThreadPoolTask task = pool->tasks[pool->head++];
+    MutexUnlock(&pool->lock);
+    task.func(task.arg);
+    MutexLock(&pool->lock);
+
+    if (--pool->pending == 0) CondVarBroadcast(&pool->idle);
+  }
+  MutexUnlock(&pool->lock);
+  return NULL;
+}
+
+ThreadPool *ThreadPoolCreate(size_t thread_count) {
+  if (thread_count == 0) thread_count = ThreadHardwareCount();
+
+  ThreadPool *pool = Malloc(sizeof(ThreadPool));
+  *pool = (ThreadPool){.thread_count = thread_count};
+  MutexInit(&pool->lock);
+  CondVarInit(&pool->has_work);
+  CondVarInit(&pool->idle);
+
+  pool->threads = Malloc(thread_count * sizeof(Thread));
+  for (size_t i = 0; i < thread_count; i++) {
+    pool->threads[i] = ThreadCreate(__base_thread_pool_worker, pool);
+  }
+  return pool;
+}
+
+void ThreadPoolSubmit(ThreadPool *pool, ThreadPoolFunc func, void *arg) {
+  MutexLock(&pool->lock);
+  if (pool->head == pool->length) { // queue drained, start over from the front
+    pool->head = 0;
+    pool->length = 0;
+  }
+
+  if (pool->length == pool->capacity) {
+    pool->capacity = pool->capacity == 0 ? 64 : pool->capacity * 2;
+    pool->tasks = Realloc(pool->tasks, pool->capacity * sizeof(__ThreadPoolTask));
+  }
+
+  pool->tasks[pool->length++] = (__ThreadPoolTask){.func = func, .arg = arg};
+  pool->pending++;
+  CondVarSignal(&pool->has_work);
+  MutexUnlock(&pool->lock);
+}
+
+void ThreadPoolWait(ThreadPool *pool) {
+  MutexLock(&pool->lock);
+  while (pool->pending > 0) {
+    CondVarWait(&pool->idle, &pool->lock);
+  }
+  MutexUnlock(&pool->lock);
+}
+
+void ThreadPoolDestroy(ThreadPool *pool) {
+  MutexLock(&pool->lock);
+  pool->stopping = true;
+  CondVarBroadcast(&pool->has_work);
+  MutexUnlock(&pool->lock);
+
+  for (size_t i = 0; i < pool->thread_count; i++) {
+    ThreadJoin(pool->threads[i]);
+  }
+
+  CondVarDestroy(&pool->has_work);
+  CondVarDestroy(&pool->idle);
+  MutexDestroy(&pool->lock);
+  Free(pool->threads);
+  if (pool->tasks) Free(pool->tasks);
+  Free(pool);
+}
+
+#  if defined(BASE_COMPILER_GCC) || defined(BASE_COMPILER_CLANG)
+size_t AtomicLoad(volatile size_t *target) {
+  return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+}
+
+void AtomicStore(volatile size_t *target, size_t value) {
+  __atomic_store_n(target, value, __ATOMIC_RELEASE);
+}
+
+size_t AtomicFetchAdd(volatile size_t *target, size_t value) {
+  return __atomic_fetch_add(target, value, __ATOMIC_ACQ_REL);
+}
+
+bool AtomicCompareExchange(volatile size_t *target, size_t *expected, size_t desired) {
+  return __atomic_compare_exchange_n(target, expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#  elif defined(BASE_COMPILER_MSVC)
+#    if defined(_WIN64)
+#      define __BASE_INTERLOCKED_ADD(target, value) (size_t) InterlockedExchangeAdd64((volatile LONG64 *)(target), (LONG64)(value))
+#      define __BASE_INTERLOCKED_CAS(target, desired, expected) (size_t) InterlockedCompareExchange64((volatile LONG64 *)(target), (LONG64)(desired), (LONG64)(expected))
+#    else
+#      define __BASE_INTERLOCKED_ADD(target, value) (size_t) InterlockedExchangeAdd((volatile LONG *)(target), (LONG)(value))
+#      define __BASE_INTERLOCKED_CAS(target, desired, expected) (size_t) InterlockedCompareExchange((volatile LONG *)(target), (LONG)(desired), (LONG)(expected))
+#    endif
+
+size_t AtomicLoad(volatile size_t *target) {
+  return __BASE_INTERLOCKED_ADD(target, 0);
+}
+
+void AtomicStore(volatile size_t *target, size_t value) {
+  size_t expected = *target;
+  while (!AtomicCompareExchange(target, &expected, value)) {}
+}
+
+size_t AtomicFetchAdd(volatile size_t *target, size_t value) {
+  return __BASE_INTERLOCKED_ADD(target, value);
+}
+
+bool AtomicCompareExchange(volatile size_t *target, size_t *expected, size_t desired) {
+  size_t previous = __BASE_INTERLOCKED_CAS(target, desired, *expected);
+  if (previous == *expected) return true;
+  *expected = previous;
+  return false;
+}
+#  else
+// NOTE: No atomic builtins on TCC, every operation goes through one global lock
+static Mutex __base_atomic_lock = MUTEX_INIT;
+
+size_t AtomicLoad(volatile size_t *target) {
+  MutexLock(&__base_atomic_lock);
+  size_t value = *target;
+  MutexUnlock(&__base_atomic_lock);
+  return value;
+}
+
+void AtomicStore(volatile size_t *target, size_t value) {
+  MutexLock(&__base_atomic_lock);
+  *target = value;
+  MutexUnlock(&__base_atomic_lock);
+}
+
+size_t AtomicFetchAdd(volatile size_t *target, size_t value) {
+  MutexLock(&__base_atomic_lock);
+  size_t previous = *target;
+  *target = previous + value;
+  MutexUnlock(&__base_atomic_lock);
+  return previous;
+}
+
+bool AtomicCompareExchange(volatile size_t *target, size_t *expected, size_t desired) {
+  MutexLock(&__base_atomic_lock);
+  bool swapped = *target == *expected;
+  if (swapped) *target = desired;
+  else *expected = *target;
+  MutexUnlock(&__base_atomic_lock);
+  return swapped;
+}
+#  endif
+
+/*   }}} --- Arena Implementations --- {{{   */
+#  if defined(BASE_PLATFORM_WIN)
+static void *__base_vm_reserve(size_t size) {
+  return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+static bool __base_vm_commit(void *address, size_t size) {
+  return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
+static void __base_vm_decommit(void *address, size_t size) {
+  VirtualFree(address, size, MEM_DECOMMIT);
+}
+
+static void __base_vm_release(void *address, size_t size) {
+  (void)size;
+  VirtualFree(address, 0, MEM_RELEASE);
+}
+#  elif defined(BASE_PLATFORM_EMSCRIPTEN)
+// NOTE: No PROT_NONE reservations on wasm, the whole range gets allocated up front
+static void *__base_vm_reserve(size_t size) {
+  return calloc(1, size);
+}
+
+static bool __base_vm_commit(void *address, size_t size) {
+  (void)address;
+  (void)size;
+  return true;
+}
+
+static void __base_vm_decommit(void *address, size_t size) {
+  memset(address, 0, size);
+}
+
+static void __base_vm_release(void *address, size_t size) {
+  (void)size;
+  free(address);
+}
+#  else
+#    if !defined(MAP_ANONYMOUS)
+#      define MAP_ANONYMOUS MAP_ANON
+#    endif
+#    if !defined(MAP_NORESERVE)
+#      define MAP_NORESERVE 0
+#    endif
+
+static void *__base_vm_reserve(size_t size) {
+  void *address = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  return address == MAP_FAILED ? NULL : address;
+}
+
+static bool __base_vm_commit(void *address, size_t size) {
+  return mprotect(address, size, PROT_READ | PROT_WRITE) == SUCCESS;
+}
+
+// Mapping over the range drops its pages, they come back zeroed if committed again
+static void __base_vm_decommit(void *address, size_t size) {
+  mmap(address, size, PROT_NONE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+}
+
+static void __base_vm_release(void *address, size_t size) {
+  munmap(address, size);
+}
+#  endif
+
+static size_t __base_align_up(size_t value, size_t align) {
+  return (value + align - 1) / align * align;
+}
+
+// Commit enough of the reserved range so `end` bytes of the buffer are usable
+static void __base_arena_commit(Arena *arena, size_t end) {
+  size_t needed = __base_align_up(sizeof(__ArenaChunk) + end, arena->chunk_size);
+  if (needed > arena->reserved) needed = arena->reserved;
+
+  bool committed = __base_vm_commit((char *)arena->root + arena->committed, needed - arena->committed);
+  Assert(committed, "ArenaPush: failed to commit %zu bytes", needed - arena->committed);
+  arena->committed = needed;
+}
+
+// Keep the committed range and watermarks of a reserved arena up with its offset
+static void __base_arena_reserved_grow(Arena *arena) {
+  if (sizeof(__ArenaChunk) + arena->offset > arena->committed) __base_arena_commit(arena, arena->offset);
+  if (arena->offset > arena->high_water) {
+    arena->high_water = arena->offset;
+    if (arena->offset > arena->dirty) arena->dirty = arena->offset;
+  }
+}
+
+// Insert `chunk` in the free list keeping it sorted by capacity
+static void __base_arena_free_list_insert(Arena *arena, __ArenaChunk *chunk) {
+  __ArenaChunk **link = &arena->free_list;
+  while (*link && (*link)->cap < chunk->cap) {
+    link = &(*link)->next;
+  }
+  chunk->next = *link;
+  *link = chunk;
+}
+
+// Move every chunk from `chunk` onwards to the free list
+static void __base_arena_release_chunks(Arena *arena, __ArenaChunk *chunk) {
+  while (chunk) {
+    __ArenaChunk *next = chunk->next;
+    chunk->idle = 0;
+    __base_arena_free_list_insert(arena, chunk);
+    chunk = next;
+  }
+}
+
+static Mutex __base_chunk_pool_lock = MUTEX_INIT;
+static __ArenaChunk *__base_chunk_pool = NULL;
+static size_t __base_chunk_pool_count = 0;
+
+static __ArenaChunk *__base_arena_chunk_alloc(Arena *arena, size_t bytes) {
+  if (arena->pooled && bytes <= ARENA_POOL_CHUNK_SIZE) {
+    MutexLock(&__base_chunk_pool_lock);
+    __ArenaChunk *chunk = __base_chunk_pool;
+    if (chunk) {
+      __base_chunk_pool = chunk->next;
+      __base_chunk_pool_count--;
+    }
+    MutexUnlock(&__base_chunk_pool_lock);
+
+    if (chunk) return chunk;
+    bytes = ARENA_POOL_CHUNK_SIZE;
+  }
+
+  __ArenaChunk *chunk = (__ArenaChunk *)Malloc(sizeof(__ArenaChunk) + bytes);
+  chunk->cap = bytes;
+  return chunk;
+}
+
+static void __base_arena_chunk_free(Arena *arena, __ArenaChunk *chunk) {
+  if (arena->pooled && chunk->cap == ARENA_POOL_CHUNK_SIZE) {
+    MutexLock(&__base_chunk_pool_lock);
+    bool pooled = __base_chunk_pool_count < ARENA_POOL_MAX_CHUNKS;
+    if (pooled) {
+      chunk->next = __base_chunk_pool;
+      __base_chunk_pool = chunk;
+      __base_chunk_pool_count++;
+    }
+    MutexUnlock(&__base_chunk_pool_lock);
+    if (pooled) return;
+  }
+
+  Free(chunk);
+}
+
+// Free idle chunks, then keep the smallest ones that fit in `retain_bytes`
+static void __base_arena_trim(Arena *arena) {
+  size_t retained = 0;
+  __ArenaChunk **link = &arena->free_list;
+  while (*link) {
+    __ArenaChunk *chunk = *link;
+    bool idle = arena->max_idle_resets && chunk->idle >= arena->max_idle_resets;
+    if (idle || chunk->cap > arena->retain_bytes - retained) {
+      *link = chunk->next;
+      __base_arena_chunk_free(arena, chunk);
+      continue;
+    }
+
+    retained += chunk->cap;
+    link = &chunk->next;
+  }
+}
+
+// Take the smallest free chunk that can fit `bytes` or allocate a new one
+static void __ArenaNextChunk(Arena *arena, size_t bytes) {
+  if (arena->current) { // chunks past `current` were left behind by `ArenaTempEnd`
+    __base_arena_release_chunks(arena, arena->current->next);
+    arena->current->next = NULL;
+  }
+
+  __ArenaChunk **link = &arena->free_list;
+  while (*link && (*link)->cap < bytes) {
+    link = &(*link)->next;
+  }
+
+  __ArenaChunk *next = *link;
+  if (next) {
+    *link = next->next;
+  } else {
+    next = __base_arena_chunk_alloc(arena, bytes);
+  }
+
+  next->next = NULL;
+  next->idle = 0;
+  if (arena->current) arena->current->next = next;
+  arena->current = next;
+}
+
+void *ArenaAlloc(Arena *arena, const size_t size) {
+  return ArenaAllocAligned(arena, size, DEFAULT_ALIGNMENT);
+}
+
+char *ArenaAllocChars(Arena *arena, size_t count) {
+  return (char *)ArenaAllocAligned(arena, count, 1);
+}
+
+void *ArenaAllocNoZero(Arena *arena, size_t size) {
+  return ArenaPush(arena, size, DEFAULT_ALIGNMENT);
+}
+
+char *ArenaAllocCharsNoZero(Arena *arena, size_t count) {
+  return (char *)ArenaPush(arena, count, 1);
+}
+
+void *ArenaAllocAligned(Arena *arena, size_t size, size_t al) {
+  size_t dirty = arena->dirty;
+  char *result = (char *)ArenaPush(arena, size, al);
+
+  if (arena->reserved) { // past `dirty` the pages are fresh from the OS and already zero
+    size_t start = (size_t)(result - arena->root->buffer);
+    size = start < dirty ? Min(size, dirty - start) : 0;
+  }
+
+  if (size) memset(result, 0, size);
+  return result;
+}
+
+#  if defined(BASE_TRACK_ALLOC)
+static void __base_arena_track(Arena *arena, size_t size) {
+  arena->allocated += size;
+  arena->allocations++;
+  arena->in_use += size;
+  if (arena->in_use > arena->peak) arena->peak = arena->in_use;
+}
+#  else
+#    define __base_arena_track(arena, size) ((void)(arena), (void)(size))
+#  endif
+
+void *ArenaPush(Arena *arena, size_t size, size_t al) {
+  __base_arena_track(arena, size);
+  void *current_pos = arena->current->buffer + arena->offset;
+  intptr_t mask = al - 1;
+  intptr_t misalignment = ((intptr_t)current_pos & mask);
+  intptr_t padding = misalignment ? al - misalignment : 0;
+
+  arena->offset += padding;
+
+  void *result;
+  if (arena->offset + size > arena->current->cap) {
+    Assert(arena->reserved == 0, "ArenaPush: reserved arena out of space, reserved %zu bytes", arena->reserved);
+    size_t bytes = Max(size + al - 1, arena->chunk_size); // room for the worst case padding
+    __ArenaNextChunk(arena, bytes);
+
+    current_pos = arena->current->buffer;
+    misalignment = ((intptr_t)current_pos & mask);
+    padding = misalignment ? al - misalignment : 0;
+    arena->offset = padding;
+
+    result = arena->current->buffer + arena->offset;
+    arena->offset += size;
+  } else {
+    result = arena->current->buffer + arena->offset;
+    arena->offset += size;
+    if (arena->reserved) __base_arena_reserved_grow(arena);
+  }
+
+  return result;
+}
+
+void *ArenaResize(Arena *arena, void *ptr, size_t old_size, size_t new_size) {
+  return ArenaResizeAligned(arena, ptr, old_size, new_size, DEFAULT_ALIGNMENT);
+}
+
+void *ArenaResizeAligned(Arena *arena, void *ptr, size_t old_size, size_t new_size, size_t align) {
+  if (ptr == NULL) return ArenaPush(arena, new_size, align);
+
+  char *start = (char *)ptr;
+  char *buffer = arena->current->buffer;
+  bool is_last = start + old_size == buffer + arena->offset;
+  if (is_last && (size_t)(start - buffer) + new_size <= arena->current->cap) {
+#  if defined(BASE_TRACK_ALLOC)
+    if (new_size > old_size) __base_arena_track(arena, new_size - old_size);
+    else arena->in_use -= Min(old_size - new_size, arena->in_use);
+#  endif
+    arena->offset = (size_t)(start - buffer) + new_size;
+    if (arena->reserved) __base_arena_reserved_grow(arena);
+    return ptr;
+  }
+
+  // Shrinking in the middle of the arena just keeps the block, copying would only waste space
+  if (new_size <= old_size && ((uintptr_t)ptr & (align - 1)) == 0) return ptr;
+
+  void *result = ArenaPush(arena, new_size, align);
+  memcpy(result, ptr, old_size);
+  return result;
+}
+
+void ArenaFree(Arena *arena) {
+  if (arena->reserved) {
+    __base_vm_release(arena->root, arena->reserved);
+    Free(arena);
+    return;
+  }
+
+  __ArenaChunk *lists[] = {arena->root, arena->free_list};
+  for (size_t i = 0; i < ARR_LEN(lists); i++) {
+    __ArenaChunk *chunk = lists[i];
+    while (chunk) {
+      __ArenaChunk *next = chunk->next;
+      __base_arena_chunk_free(arena, chunk);
+      chunk = next;
+    }
+  }
+  Free(arena);
+}
+
+void ArenaReset(Arena *arena) {
+  arena->current = arena->root;
+  arena->offset = 0;
+#  if defined(BASE_TRACK_ALLOC)
+  arena->in_use = 0;
+#  endif
+
+  if (arena->reserved) { // keep what the last cycle used, hand back the rest
+    size_t keep = __base_align_up(sizeof(__ArenaChunk) + arena->high_water, arena->chunk_size);
+    if (keep < arena->committed) {
+      __base_vm_decommit((char *)arena->root + keep, arena->committed - keep);
+      arena->committed = keep;
+      arena->dirty = Min(arena->dirty, keep - sizeof(__ArenaChunk));
+    }
+    arena->high_water = 0;
+    return;
+  }
+
+  for (__ArenaChunk *chunk = arena->free_list; chunk; chunk = chunk->next) {
+    chunk->idle++;
+  }
+  __base_arena_release_chunks(arena, arena->root->next);
+  arena->root->next = NULL;
+  __base_arena_trim(arena);
+}
+
+void ArenaSetRetention(Arena *arena, size_t retain_bytes, size_t max_idle_resets) {
+  arena->retain_bytes = retain_bytes;
+  arena->max_idle_resets = max_idle_resets;
+}
+
+Arena *ArenaCreate(size_t chunk_size) {
+  Arena *res = Malloc(sizeof(Arena));
+  memset(res, 0, sizeof(*res));
+  res->chunk_size = chunk_size;
+  res->retain_bytes = SIZE_MAX;
+  __ArenaNextChunk(res, chunk_size);
+  res->root = res->current;
+  return res;
+}
+
+Arena *ArenaCreateReserved(size_t reserve_bytes) {
+  Assert(reserve_bytes > 0, "ArenaCreateReserved: reserve_bytes cant be zero");
+  size_t reserved = __base_align_up(reserve_bytes + sizeof(__ArenaChunk), ARENA_COMMIT_SIZE);
+
+  __ArenaChunk *root = (__ArenaChunk *)__base_vm_reserve(reserved);
+  Assert(root != NULL, "ArenaCreateReserved: failed to reserve %zu bytes", reserved);
+  bool committed = __base_vm_commit(root, ARENA_COMMIT_SIZE);
+  Assert(committed, "ArenaCreateReserved: failed to commit %zu bytes", (size_t)ARENA_COMMIT_SIZE);
+
+  root->next = NULL;
+  root->cap = reserved - sizeof(__ArenaChunk);
+
+  Arena *res = Malloc(sizeof(Arena));
+  memset(res, 0, sizeof(*res));
+  res->root = root;
+  res->current = root;
+  res->chunk_size = ARENA_COMMIT_SIZE;
+  res->reserved = reserved;
+  res->committed = ARENA_COMMIT_SIZE;
+  return res;
+}
+
+ArenaTemp ArenaTempBegin(Arena *arena) {
+  ArenaTemp temp = {.arena = arena, .current = arena->current, .offset = arena->offset};
+#  if defined(BASE_TRACK_ALLOC)
+  temp.in_use = arena->in_use;
+#  endif
+  return temp;
+}
+
+void ArenaTempEnd(ArenaTemp temp) {
+  Assert(temp.arena != NULL, "ArenaTempEnd: temp was not created with `ArenaTempBegin`");
+  temp.arena->current = temp.current;
+  temp.arena->offset = temp.offset;
+#  if defined(BASE_TRACK_ALLOC)
+  temp.arena->in_use = temp.in_use;
 #  endif
 }
 
-CompilerFamily GetCompilerFamily(void) {
-#  if defined(BASE_COMPILER_CLANG)
-  return COMPILER_CLANG;
-#  elif defined(BASE_COMPILER_GCC)
-  return COMPILER_GCC;
-#  elif defined(BASE_COMPILER_MSVC)
-  return COMPILER_MSVC;
-#  elif defined(BASE_COMPILER_TCC)
-  return COMPILER_TCC;
-#  else
-#    error "base.h: Unsupported compiler"
+ArenaStats ArenaGetStats(Arena *arena) {
+  ArenaStats stats = {0};
+  if (arena->reserved) {
+    stats.chunks = 1;
+    stats.capacity = arena->committed;
+  } else {
+    __ArenaChunk *lists[] = {arena->root, arena->free_list};
+    for (size_t i = 0; i < ARR_LEN(lists); i++) {
+      for (__ArenaChunk *chunk = lists[i]; chunk; chunk = chunk->next) {
+        stats.chunks++;
+        stats.capacity += chunk->cap;
+      }
+    }
+  }
+
+#  if defined(BASE_TRACK_ALLOC)
+  stats.allocated = arena->allocated;
+  stats.allocations = arena->allocations;
+  stats.in_use = arena->in_use;
+  stats.peak = arena->peak;
 #  endif
+  return stats;
 }
 
-char *GetCompilerStr(void) {
-#  if defined(BASE_COMPILER_CLANG)
-#    if defined(BASE_COMPILER_FILC)
-  return "filc";
+#  if defined(BASE_COMPILER_TCC)
+// NOTE: No TLS on TCC, each thread gets a node in a lock protected list keyed by its id,
+// nodes never move so the owning thread can keep using the pointer without the lock
+typedef struct __ThreadLocals {
+  struct __ThreadLocals *next;
+  size_t id;
+  Arena *scratch_arenas[SCRATCH_ARENA_COUNT];
+  Arena *thread_arena;
+} __ThreadLocals;
+
+static Mutex __base_thread_locals_lock = MUTEX_INIT;
+static __ThreadLocals *__base_thread_locals = NULL;
+
+static __ThreadLocals *__base_thread_locals_get(void) {
+#    if defined(BASE_PLATFORM_WIN)
+  size_t id = (size_t)GetCurrentThreadId();
 #    else
-  return "clang";
+  size_t id = (size_t)pthread_self();
 #    endif
-#  elif defined(BASE_COMPILER_GCC)
-  return "gcc";
-#  elif defined(BASE_COMPILER_MSVC)
-  return "cl.exe";
-#  elif defined(BASE_COMPILER_TCC)
-  return "tcc";
+
+  MutexLock(&__base_thread_locals_lock);
+  __ThreadLocals *locals = __base_thread_locals;
+  while (locals != NULL && locals->id != id) {
+    locals = locals->next;
+  }
+
+  if (locals == NULL) {
+    locals = Malloc(sizeof(__ThreadLocals));
+    memset(locals, 0, sizeof(*locals));
+    locals->id = id;
+    locals->next = __base_thread_locals;
+    __base_thread_locals = locals;
+  }
+  MutexUnlock(&__base_thread_locals_lock);
+  return locals;
+}
+
+static Arena **__base_scratch_arenas_get(void) {
+  return __base_thread_locals_get()->scratch_arenas;
+}
+
+static Arena **__base_thread_arena_get(void) {
+  return &__base_thread_locals_get()->thread_arena;
+}
 #  else
-#    error "base.h: Unsupported compiler"
-#  endif
+static THREAD_LOCAL Arena *__base_scratch_arenas[SCRATCH_ARENA_COUNT];
+static THREAD_LOCAL Arena *__base_thread_arena = NULL;
+
+static Arena **__base_scratch_arenas_get(void) {
+  return __base_scratch_arenas;
 }
 
-/* --- Error Implementation --- */
-#  if defined(BASE_PLATFORM_WIN)
-Error ErrnoMatch(errno_t err) {
-  switch (err) {
-    case ERROR_FILE_NOT_FOUND:
-    case ERROR_PATH_NOT_FOUND:      return FILE_NOT_FOUND;
-    case ERROR_NOT_ENOUGH_MEMORY:
-    case ERROR_OUTOFMEMORY:         return FILE_NO_MEMORY;
-    case ERROR_ACCESS_DENIED:       return FILE_ACCESS_DENIED;
-    case ERROR_DISK_FULL:           return FILE_DISK_FULL;
-    case ERROR_ALREADY_EXISTS:      return FILE_ALREADY_EXISTS;
-    case ERROR_TOO_MANY_OPEN_FILES: return FILE_TOO_MANY_OPEN;
-    case ERROR_BUFFER_OVERFLOW:     return FILE_PATH_TOO_LONG;
-    case ERROR_DIRECTORY:           return FILE_IS_DIRECTORY;
-    case ERROR_WRITE_PROTECT:       return FILE_READ_ONLY_FS;
+static Arena **__base_thread_arena_get(void) {
+  return &__base_thread_arena;
+}
+#  endif
+
+ArenaTemp ScratchBegin(Arena **conflicts, size_t conflict_count) {
+  Arena **scratch_arenas = __base_scratch_arenas_get();
+  for (size_t i = 0; i < SCRATCH_ARENA_COUNT; i++) {
+    if (scratch_arenas[i] == NULL) {
+      scratch_arenas[i] = ArenaCreate(ARENA_COMMIT_SIZE);
+    }
+
+    bool conflicting = false;
+    for (size_t j = 0; j < conflict_count; j++) {
+      if (conflicts[j] == scratch_arenas[i]) {
+        conflicting = true;
+        break;
+      }
+    }
+
+    if (!conflicting) return ArenaTempBegin(scratch_arenas[i]);
   }
-  return FILE_ACCESS_DENIED;
+
+  Unreachable("ScratchBegin: every scratch arena conflicts, raise `SCRATCH_ARENA_COUNT`");
+  return (ArenaTemp){0};
 }
-#else
-Error ErrnoMatch(errno_t err) {
-  if (err == SUCCESS) return SUCCESS;
-  switch (err) {
-    case ENOENT:       return FILE_NOT_FOUND;
-    case ENOMEM:       return FILE_NO_MEMORY;
-    case ENOSPC:       return FILE_DISK_FULL;
-    case EMFILE:       return FILE_TOO_MANY_OPEN;
-    case ENFILE:       return FILE_TOO_MANY_OPEN;
-    case EACCES:       return FILE_ACCESS_DENIED;
-    case ENAMETOOLONG: return FILE_PATH_TOO_LONG;
-    case EISDIR:       return FILE_IS_DIRECTORY;
-    case EROFS:        return FILE_READ_ONLY_FS;
-    case EEXIST:       return FILE_ALREADY_EXISTS;
+
+void ScratchEnd(ArenaTemp temp) {
+  ArenaTempEnd(temp);
+}
+
+void ScratchFree(void) {
+  Arena **scratch_arenas = __base_scratch_arenas_get();
+  for (size_t i = 0; i < SCRATCH_ARENA_COUNT; i++) {
+    if (scratch_arenas[i] == NULL) continue;
+    ArenaFree(scratch_arenas[i]);
+    scratch_arenas[i] = NULL;
   }
-  return FILE_ACCESS_DENIED;
 }
-#endif
 
-String ErrToStr(errno_t err) {
-  switch (err) {
-    case FILE_ACCESS_DENIED:  return S("File access denied");
-    case FILE_NOT_FOUND:      return S("File not found");
-    case FILE_NO_MEMORY:      return S("File no memory");
-    case FILE_DISK_FULL:      return S("File disk full");
-    case FILE_READ_FAILED:    return S("File read Failed");
-    case FILE_WRITE_FAILED:   return S("File write failed");
-    case FILE_TOO_MANY_OPEN:  return S("File too many open");
-    case FILE_PATH_TOO_LONG:  return S("File path too long");
-    case FILE_IS_DIRECTORY:   return S("File is directory");
-    case FILE_READ_ONLY_FS:   return S("File read only FS");
-    case FILE_ALREADY_EXISTS: return S("File already exists");
+Arena *ThreadArena(void) {
+  Arena **thread_arena = __base_thread_arena_get();
+  if (*thread_arena == NULL) {
+    Arena *res = Malloc(sizeof(Arena));
+    memset(res, 0, sizeof(*res));
+    res->chunk_size = ARENA_POOL_CHUNK_SIZE;
+    res->retain_bytes = SIZE_MAX;
+    res->pooled = true;
+    __ArenaNextChunk(res, ARENA_POOL_CHUNK_SIZE);
+    res->root = res->current;
+    *thread_arena = res;
   }
 
-  return S("");
+  return *thread_arena;
 }
 
-static void _custom_assert(const char *expr, const char *file, unsigned line, const char *format, ...) {
-  printf("%sAssertion failed: %s, file %s, line %u %s\n", _RED, expr, file, line, _RESET);
+void ThreadArenaRelease(void) {
+  Arena **thread_arena = __base_thread_arena_get();
+  if (*thread_arena == NULL) return;
+  ArenaFree(*thread_arena);
+  *thread_arena = NULL;
+}
 
-  if (format) {
-    va_list args;
-    va_start(args, format);
-    logErrorV(format, args);
-    va_end(args);
+void ThreadArenaPoolTrim(size_t keep_chunks) {
+  __ArenaChunk *trimmed = NULL;
+  MutexLock(&__base_chunk_pool_lock);
+  while (__base_chunk_pool_count > keep_chunks) {
+    __ArenaChunk *chunk = __base_chunk_pool;
+    __base_chunk_pool = chunk->next;
+    __base_chunk_pool_count--;
+    chunk->next = trimmed;
+    trimmed = chunk;
   }
+  MutexUnlock(&__base_chunk_pool_lock);
 
-  fflush(stdout);
-  abort();
+  while (trimmed) { // freed outside the lock
+    __ArenaChunk *next = trimmed->next;
+    Free(trimmed);
+    trimmed = next;
+  }
 }
 
-static void _custom_unreachable(const char *file, unsigned line, const char *format, ...) {
-  printf("%sReached Unreachable code at file %s, line %u %s\n", _RED, file, line, _RESET);
+// Make sure `end` bytes of the shared arena are committed
+static void __base_shared_arena_commit(SharedArena *arena, size_t end) {
+  if (end <= AtomicLoad(&arena->committed)) return;
+
+  MutexLock(&arena->commit_lock);
+  size_t committed = AtomicLoad(&arena->committed);
+  if (end > committed) {
+    size_t needed = Min(__base_align_up(end, ARENA_COMMIT_SIZE), arena->reserved);
+    bool ok = __base_vm_commit(arena->base + committed, needed - committed);
+    Assert(ok, "SharedArenaAlloc: failed to commit %zu bytes", needed - committed);
+    AtomicStore(&arena->committed, needed);
+  }
+  MutexUnlock(&arena->commit_lock);
+}
 
-  if (format) {
-    va_list args;
-    va_start(args, format);
-    logErrorV(format, args);
-    va_end(args);
+void *SharedArenaAlloc(SharedArena *arena, size_t size) {
+  return SharedArenaAllocAligned(arena, size, DEFAULT_ALIGNMENT);
+}
+
+void *SharedArenaAllocAligned(SharedArena *arena, size_t size, size_t al) {
+  size_t start = AtomicFetchAdd(&arena->offset, size + al - 1); // room for the worst case padding
+  Assert(start + size + al - 1 <= arena->reserved, "SharedArenaAlloc: out of space, reserved %zu bytes", arena->reserved);
+
+  uintptr_t address = (uintptr_t)(arena->base + start);
+  char *result = (char *)((address + (al - 1)) & ~(uintptr_t)(al - 1));
+  __base_shared_arena_commit(arena, (size_t)(result - arena->base) + size);
+
+  // NOTE: No memset, `SharedArenaReset` zeroes or decommits every used page so memory always comes zeroed
+  return result;
+}
+
+void SharedArenaReset(SharedArena *arena) {
+  size_t committed = AtomicLoad(&arena->committed);
+  size_t used = Min(AtomicLoad(&arena->offset), committed);
+
+  // Keep what the last cycle used committed and zero it, hand back the rest
+  size_t keep = Min(__base_align_up(used, ARENA_COMMIT_SIZE), committed);
+  memset(arena->base, 0, used);
+  if (keep < committed) __base_vm_decommit(arena->base + keep, committed - keep);
+  AtomicStore(&arena->committed, keep);
+  AtomicStore(&arena->offset, 0);
+}
+
+void SharedArenaFree(SharedArena *arena) {
+  __base_vm_release(arena->base, arena->reserved);
+  MutexDestroy(&arena->commit_lock);
+  Free(arena);
+}
+
+SharedArena *SharedArenaCreate(size_t reserve_bytes) {
+  Assert(reserve_bytes > 0, "SharedArenaCreate: reserve_bytes cant be zero");
+  SharedArena *res = Malloc(sizeof(SharedArena));
+  memset(res, 0, sizeof(*res));
+
+  res->reserved = __base_align_up(reserve_bytes, ARENA_COMMIT_SIZE);
+  res->base = (char *)__base_vm_reserve(res->reserved);
+  Assert(res->base != NULL, "SharedArenaCreate: failed to reserve %zu bytes", res->reserved);
+  MutexInit(&res->commit_lock);
+  return res;
+}
+
+/*   }}} --- Pool Implementations --- {{{   */
+void *PoolAlloc(Pool *pool) {
+  void *result = pool->free_list;
+  if (result) {
+    pool->free_list = *(void **)result;
+  } else {
+    if (pool->slab_left == 0) {
+      pool->slab = ArenaPush(pool->arena, pool->elem_size * pool->slab_count, pool->align);
+      pool->slab_left = pool->slab_count;
+    }
+
+    result = pool->slab;
+    pool->slab += pool->elem_size;
+    pool->slab_left--;
   }
 
-  fflush(stdout);
-  abort();
+  memset(result, 0, pool->elem_size);
+  return result;
 }
 
-/*   }}} --- Arena Implementations --- {{{   */
-// Allocate or iterate to next chunk that can fit `bytes`
-static void __ArenaNextChunk(Arena *arena, size_t bytes) {
-  __ArenaChunk *next = arena->current ? arena->current->next : NULL;
-  while (next) {
-    arena->current = next;
-    if (arena->current->cap > bytes) {
-      return;
+void PoolFree(Pool *pool, void *ptr) {
+  *(void **)ptr = pool->free_list;
+  pool->free_list = ptr;
+}
+
+void PoolReset(Pool *pool) {
+  ArenaReset(pool->arena);
+  pool->free_list = NULL;
+  pool->slab = NULL;
+  pool->slab_left = 0;
+}
+
+void PoolDestroy(Pool *pool) {
+  ArenaFree(pool->arena);
+  Free(pool);
+}
+
+Pool *PoolCreate(size_t elem_size, size_t align) {
+  Assert(elem_size != 0, "PoolCreate: elem_size cant be zero");
+  Assert(align != 0 && (align & (align - 1)) == 0, "PoolCreate: align must be a power of two, got %zu", align);
+
+  Pool *res = Malloc(sizeof(Pool));
+  memset(res, 0, sizeof(*res));
+  res->align = Max(align, sizeof(void *));
+  res->elem_size = __base_align_up(Max(elem_size, sizeof(void *)), res->align);
+  res->slab_count = Max(POOL_SLAB_SIZE / res->elem_size, (size_t)1);
+  res->arena = ArenaCreate(res->elem_size * res->slab_count + res->align);
+  return res;
+}
+
+/*   }}} --- Memory Allocation Implementations --- {{{   */
+#  if defined(BASE_TRACK_ALLOC)
+typedef struct {
+  const char *file;
+  uint32_t line;
+  size_t calls;
+  size_t bytes;
+  size_t live_bytes;
+  size_t live_blocks;
+} __AllocSite;
+
+typedef struct {
+  size_t size;
+  size_t site;
+} __AllocHeader; // NOTE: two words keep the block at `DEFAULT_ALIGNMENT`
+
+static Mutex __base_alloc_lock = MUTEX_INIT;
+static AllocStats __base_alloc_stats = {0};
+static __AllocSite __base_alloc_sites[ALLOC_TRACK_MAX_SITES];
+static bool __base_alloc_report_registered = false;
+
+static void __base_alloc_report_leaks(void) {
+  AllocStats stats = GetAllocStats();
+  if (stats.live_blocks == 0) return;
+
+  LogWarn("BASE_TRACK_ALLOC: %zu blocks (%zu bytes) never freed", stats.live_blocks, stats.live_bytes);
+  for (size_t i = 0; i < ALLOC_TRACK_MAX_SITES; i++) {
+    __AllocSite *site = &__base_alloc_sites[i];
+    if (site->file == NULL || site->live_blocks == 0) continue;
+    LogWarn("  %s:%u: %zu blocks, %zu bytes", site->file, site->line, site->live_blocks, site->live_bytes);
+  }
+}
+
+// Find or claim the slot of `file:line`, must hold `__base_alloc_lock`
+static size_t __base_alloc_site(const char *file, uint32_t line) {
+  if (!__base_alloc_report_registered) {
+    __base_alloc_report_registered = true;
+    atexit(__base_alloc_report_leaks);
+  }
+
+  size_t index = ((uintptr_t)file * 31 + line) % ALLOC_TRACK_MAX_SITES;
+  for (size_t probe = 0; probe < ALLOC_TRACK_MAX_SITES; probe++) {
+    __AllocSite *site = &__base_alloc_sites[index];
+    if (site->file == NULL) {
+      site->file = file;
+      site->line = line;
+      return index;
     }
-    next = arena->current->next;
+    if (site->file == file && site->line == line) return index;
+    index = (index + 1) % ALLOC_TRACK_MAX_SITES;
   }
-  next = (__ArenaChunk *)Malloc(sizeof(__ArenaChunk) + bytes);
-  next->cap = bytes;
-  next->next = NULL;
-  if (arena->current) arena->current->next = next;
-  arena->current = next;
+
+  Unreachable("BASE_TRACK_ALLOC: more than %d call sites, raise `ALLOC_TRACK_MAX_SITES`", ALLOC_TRACK_MAX_SITES);
+  return 0;
 }
 
-void *ArenaAlloc(Arena *arena, const size_t size) {
-  return ArenaAllocAligned(arena, size, DEFAULT_ALIGNMENT);
+// Account `header` as a live block of `size` bytes, must hold `__base_alloc_lock`
+static void __base_alloc_track(__AllocHeader *header, size_t size, const char *file, uint32_t line) {
+  header->size = size;
+  header->site = __base_alloc_site(file, line);
+
+  __AllocSite *site = &__base_alloc_sites[header->site];
+  site->calls++;
+  site->bytes += size;
+  site->live_bytes += size;
+  site->live_blocks++;
+
+  __base_alloc_stats.bytes_allocated += size;
+  __base_alloc_stats.live_bytes += size;
+  __base_alloc_stats.live_blocks++;
+  if (__base_alloc_stats.live_bytes > __base_alloc_stats.peak_live_bytes) {
+    __base_alloc_stats.peak_live_bytes = __base_alloc_stats.live_bytes;
+  }
 }
 
-char *ArenaAllocChars(Arena *arena, size_t count) {
-  return (char *)ArenaAllocAligned(arena, count, 1);
+// Drop `header` from the live counters, must hold `__base_alloc_lock`
+static void __base_alloc_untrack(__AllocHeader *header) {
+  __AllocSite *site = &__base_alloc_sites[header->site];
+  site->live_bytes -= header->size;
+  site->live_blocks--;
+  __base_alloc_stats.live_bytes -= header->size;
+  __base_alloc_stats.live_blocks--;
+}
+
+void *__base_malloc_at(size_t size, const char *file, uint32_t line) {
+  Assert(size != 0, "Malloc: size cant be zero");
+  __AllocHeader *header = malloc(sizeof(__AllocHeader) + size);
+  Assert(header != NULL, "Malloc: failed, returned address should never be NULL");
+
+  MutexLock(&__base_alloc_lock);
+  __base_alloc_stats.mallocs++;
+  __base_alloc_track(header, size, file, line);
+  MutexUnlock(&__base_alloc_lock);
+  return header + 1;
+}
+
+void *__base_realloc_at(void *block, size_t size, const char *file, uint32_t line) {
+  Assert(size != 0, "Realloc: size cant be zero");
+  __AllocHeader *header = block ? (__AllocHeader *)block - 1 : NULL;
+
+  MutexLock(&__base_alloc_lock);
+  if (header) __base_alloc_untrack(header);
+  MutexUnlock(&__base_alloc_lock);
+
+  header = realloc(header, sizeof(__AllocHeader) + size);
+  Assert(header != NULL, "Realloc: failed, returned address should never be NULL");
+
+  MutexLock(&__base_alloc_lock);
+  __base_alloc_stats.reallocs++;
+  __base_alloc_track(header, size, file, line);
+  MutexUnlock(&__base_alloc_lock);
+  return header + 1;
+}
+
+void *(Malloc)(size_t size) {
+  return __base_malloc_at(size, "unknown", 0);
+}
+
+void *(Realloc)(void *block, size_t size) {
+  return __base_realloc_at(block, size, "unknown", 0);
+}
+
+void Free(void *address) {
+  if (address == NULL) return;
+  __AllocHeader *header = (__AllocHeader *)address - 1;
+  MutexLock(&__base_alloc_lock);
+  __base_alloc_stats.frees++;
+  __base_alloc_untrack(header);
+  MutexUnlock(&__base_alloc_lock);
+  free(header);
+}
+
+AllocStats GetAllocStats(void) {
+  MutexLock(&__base_alloc_lock);
+  AllocStats stats = __base_alloc_stats;
+  MutexUnlock(&__base_alloc_lock);
+  return stats;
+}
+
+void AllocReport(void) {
+  AllocStats stats = GetAllocStats();
+  LogInfo("Allocations: %zu mallocs, %zu reallocs, %zu frees, %zu bytes total, %zu live (peak %zu)", stats.mallocs, stats.reallocs, stats.frees, stats.bytes_allocated, stats.live_bytes, stats.peak_live_bytes);
+
+  MutexLock(&__base_alloc_lock);
+  for (size_t i = 0; i < ALLOC_TRACK_MAX_SITES; i++) {
+    __AllocSite *site = &__base_alloc_sites[i];
+    if (site->file == NULL) continue;
+    LogInfo("  %s:%u: %zu calls, %zu bytes, %zu live", site->file, site->line, site->calls, site->bytes, site->live_bytes);
+  }
+  MutexUnlock(&__base_alloc_lock);
+}
+#  else
+void *Malloc(size_t size) {
+  Assert(size != 0, "Malloc: size cant be zero");
+  void *address = malloc(size);
+  Assert(address != NULL, "Malloc: failed, returned address should never be NULL");
+  return address;
+}
+
+void *Realloc(void *block, size_t size) {
+  Assert(size != 0, "Realloc: size cant be zero");
+  void *address = realloc(block, size);
+  Assert(address != NULL, "Realloc: failed, returned address should never be NULL");
+  return address;
+}
+
+void Free(void *address) {
+  free(address);
+}
+
+void *__base_malloc_at(size_t size, const char *file, uint32_t line) {
+  (void)file;
+  (void)line;
+  return Malloc(size);
+}
+
+void *__base_realloc_at(void *block, size_t size, const char *file, uint32_t line) {
+  (void)file;
+  (void)line;
+  return Realloc(block, size);
+}
+
+AllocStats GetAllocStats(void) {
+  return (AllocStats){0};
+}
+
+void AllocReport(void) {
+  LogWarn("AllocReport: define `BASE_TRACK_ALLOC` to track allocations");
+}
+#  endif
+
+/*   }}} --- Allocator Implementations --- {{{   */
+void *__base_allocator_alloc_at(Allocator allocator, size_t size, size_t align, const char *file, uint32_t line) {
+  if (allocator.alloc == NULL) return __base_malloc_at(size, file, line);
+  return allocator.alloc(allocator.context, size, align);
+}
+
+void *__base_allocator_resize_at(Allocator allocator, void *ptr, size_t old_size, size_t new_size, size_t align, const char *file, uint32_t line) {
+  if (allocator.resize == NULL) return __base_realloc_at(ptr, new_size, file, line);
+  return allocator.resize(allocator.context, ptr, old_size, new_size, align);
+}
+
+void *(AllocatorAlloc)(Allocator allocator, size_t size, size_t align) {
+  return __base_allocator_alloc_at(allocator, size, align, "unknown", 0);
+}
+
+void *(AllocatorResize)(Allocator allocator, void *ptr, size_t old_size, size_t new_size, size_t align) {
+  return __base_allocator_resize_at(allocator, ptr, old_size, new_size, align, "unknown", 0);
+}
+
+void AllocatorFree(Allocator allocator, void *ptr, size_t size) {
+  if (ptr == NULL) return;
+  if (allocator.free == NULL) {
+    Free(ptr);
+    return;
+  }
+  allocator.free(allocator.context, ptr, size);
 }
 
-void *ArenaAllocAligned(Arena *arena, size_t size, size_t al) {
-  void *current_pos = arena->current->buffer + arena->offset;
-  intptr_t mask = al - 1;
-  intptr_t misalignment = ((intptr_t)current_pos & mask);
-  intptr_t padding = misalignment ? al - misalignment : 0;
+static void *__base_heap_alloc(void *context, size_t size, size_t align) {
+  (void)context;
+  Assert(align <= DEFAULT_ALIGNMENT, "HeapAllocator: alignment %zu is bigger than malloc's", align);
+  return Malloc(size);
+}
 
-  arena->offset += padding;
+static void *__base_heap_resize(void *context, void *ptr, size_t old_size, size_t new_size, size_t align) {
+  (void)context;
+  (void)old_size;
+  Assert(align <= DEFAULT_ALIGNMENT, "HeapAllocator: alignment %zu is bigger than malloc's", align);
+  return Realloc(ptr, new_size);
+}
 
-  void *result;
-  if (arena->offset + size > arena->current->cap) {
-    size_t bytes = size > arena->chunk_size ? size : arena->chunk_size;
-    __ArenaNextChunk(arena, bytes);
+static void __base_heap_free(void *context, void *ptr, size_t size) {
+  (void)context;
+  (void)size;
+  Free(ptr);
+}
 
-    current_pos = arena->current->buffer;
-    misalignment = ((intptr_t)current_pos & mask);
-    padding = misalignment ? al - misalignment : 0;
-    arena->offset = padding;
+Allocator HeapAllocator(void) {
+  return (Allocator){.alloc = __base_heap_alloc, .resize = __base_heap_resize, .free = __base_heap_free};
+}
 
-    result = arena->current->buffer + arena->offset;
-    arena->offset += size;
-  } else {
-    result = arena->current->buffer + arena->offset;
-    arena->offset += size;
-  }
+static void *__base_arena_allocator_alloc(void *context, size_t size, size_t align) {
+  return ArenaPush((Arena *)context, size, align);
+}
 
-  if (size) memset(result, 0, size);
-  return result;
+static void *__base_arena_allocator_resize(void *context, void *ptr, size_t old_size, size_t new_size, size_t align) {
+  return ArenaResizeAligned((Arena *)context, ptr, old_size, new_size, align);
 }
 
-void ArenaFree(Arena *arena) {
-  __ArenaChunk *chunk = arena->root;
-  while (chunk) {
-    __ArenaChunk *next = chunk->next;
-    Free(chunk);
-    chunk = next;
-  }
-  Free(arena);
+static void __base_arena_allocator_free(void *context, void *ptr, size_t size) {
+  (void)context;
+  (void)ptr;
+  (void)size;
 }
 
-void ArenaReset(Arena *arena) {
-  arena->current = arena->root;
-  arena->offset = 0;
+Allocator ArenaAllocator(Arena *arena) {
+  return (Allocator){
+    .alloc = __base_arena_allocator_alloc,
+    .resize = __base_arena_allocator_resize,
+    .free = __base_arena_allocator_free,
+    .context = arena,
+  };
 }
 
-Arena *ArenaCreate(size_t chunk_size) {
-  Arena *res = Malloc(sizeof(Arena));
-  memset(res, 0, sizeof(*res));
-  res->chunk_size = chunk_size;
-  __ArenaNextChunk(res, chunk_size);
-  res->root = res->current;
-  return res;
+static void *__base_pool_allocator_alloc(void *context, size_t size, size_t align) {
+  Pool *pool = context;
+  Assert(size <= pool->elem_size && align <= pool->align, "PoolAllocator: %zu bytes dont fit in a %zu bytes element", size, pool->elem_size);
+  return PoolAlloc(pool);
 }
 
-/*   }}} --- Memory Allocation Implementations --- {{{   */
-void *Malloc(size_t size) {
-  Assert(size != 0, "Malloc: size cant be zero");
-  void *address = malloc(size);
-  Assert(address != NULL, "Malloc: failed, returned address should never be NULL");
-  return address;
+static void *__base_pool_allocator_resize(void *context, void *ptr, size_t old_size, size_t new_size, size_t align) {
+  (void)old_size;
+  if (ptr == NULL) return __base_pool_allocator_alloc(context, new_size, align);
+
+  Pool *pool = context;
+  Assert(new_size <= pool->elem_size, "PoolAllocator: cant grow past the %zu bytes element", pool->elem_size);
+  return ptr;
 }
 
-void *Realloc(void *block, size_t size) {
-  Assert(size != 0, "Realloc: size cant be zero");
-  void *address = realloc(block, size);
-  Assert(address != NULL, "Realloc: failed, returned address should never be NULL");
-  return address;
+static void __base_pool_allocator_free(void *context, void *ptr, size_t size) {
+  (void)size;
+  PoolFree((Pool *)context, ptr);
 }
 
-void Free(void *address) {
-  free(address);
+Allocator PoolAllocator(Pool *pool) {
+  return (Allocator){
+    .alloc = __base_pool_allocator_alloc,
+    .resize = __base_pool_allocator_resize,
+    .free = __base_pool_allocator_free,
+    .context = pool,
+  };
 }
 
 /*   }}} --- String Implementations --- {{{   */
@@ -995,7 +3649,7 @@ String F(Arena *arena, const char *format, ...) {
   size_t size = vsnprintf(NULL, 0, format, args) + 1; // +1 for null terminator
   va_end(args);
 
-  char *buffer = ArenaAllocChars(arena, size);
+  char *buffer = ArenaAllocCharsNoZero(arena, size);
   va_start(args, format);
   vsnprintf(buffer, size, format, args);
   va_end(args);
@@ -1030,7 +3684,7 @@ String StrNew(Arena *arena, char *str) {
     return (String){0};
   }
   size_t memory_size = sizeof(char) * len + 1; // NOTE: Includes null terminator
-  char *allocated_str = ArenaAllocChars(arena, memory_size);
+  char *allocated_str = ArenaAllocCharsNoZero(arena, memory_size);
 
   memcpy(allocated_str, str, memory_size);
   add_null_terminator(allocated_str, len);
@@ -1041,7 +3695,7 @@ String StrNewSize(Arena *arena, char *str, size_t len) {
   Assert(str != NULL, "StrNewSize: str should never be NULL");
 
   size_t memory_size = sizeof(char) * len + 1; // NOTE: Includes null terminator
-  char *allocated_str = ArenaAllocChars(arena, memory_size);
+  char *allocated_str = ArenaAllocCharsNoZero(arena, memory_size);
 
   memcpy(allocated_str, str, len);
   add_null_terminator(allocated_str, len);
@@ -1074,256 +3728,1018 @@ bool StrEq(String string1, String string2) {
     return false;
   }
 
-  return true;
+  return true;
+}
+
+String StrConcat(Arena *arena, String string1, String string2) {
+  if (StrIsNull(string1)) {
+    size_t len = string2.length;
+    size_t memory_size = sizeof(char) * len + 1;
+    char *allocated_string = ArenaAllocCharsNoZero(arena, memory_size);
+
+    errno_t err = memcpy_s(allocated_string, memory_size, string2.data, string2.length);
+    Assert(err == SUCCESS, "StrConcat: memcpy_s failed, err: %d", err);
+
+    add_null_terminator(allocated_string, len);
+    return (String){len, allocated_string};
+  }
+
+  if (StrIsNull(string2)) {
+    size_t len = string1.length;
+    size_t memory_size = sizeof(char) * len + 1;
+    char *allocated_string = ArenaAllocCharsNoZero(arena, memory_size);
+    errno_t err = memcpy_s(allocated_string, memory_size, string1.data, string1.length);
+    Assert(err == SUCCESS, "StrConcat: memcpy_s failed, err: %d", err);
+
+    add_null_terminator(allocated_string, len);
+    return (String){len, allocated_string};
+  }
+
+  size_t len = string1.length + string2.length;
+  size_t memory_size = sizeof(char) * len + 1;
+  char *allocated_string = ArenaAllocCharsNoZero(arena, memory_size);
+
+  errno_t err = memcpy_s(allocated_string, memory_size, string1.data, string1.length);
+  Assert(err == SUCCESS, "StrConcat: memcpy_s failed, err: %d", err);
+
+  err = memcpy_s(allocated_string + string1.length, memory_size, string2.data, string2.length);
+  Assert(err == SUCCESS, "StrConcat: memcpy_s failed, err: %d", err);
+
+  add_null_terminator(allocated_string, len);
+  return (String){len, allocated_string};
+}
+
+StringVector StrSplit(Arena *arena, String str, String delimiter) {
+  StringVector result = {0};
+  if (StrIsEmpty(delimiter) && str.length > 0) VecReserve(result, str.length);
+
+  StrSplitIter it = StrSplitBegin(str, delimiter);
+  for (String token; StrSplitNext(&it, &token);) {
+    VecPush(result, StrNewSize(arena, token.data, token.length));
+  }
+  return result;
+}
+
+StrSplitIter StrSplitBegin(String string, String delimiter) {
+  return (StrSplitIter){.rest = string, .delimiter = delimiter};
+}
+
+bool StrSplitNext(StrSplitIter *it, String *token) {
+  if (it->rest.length == 0) return false;
+
+  size_t length = 1, skip = 1; // empty delimiter splits every byte
+  if (it->delimiter.length > 0) {
+    ssize_t at = StrFind(it->rest, it->delimiter);
+    length = at < 0 ? it->rest.length : (size_t)at;
+    skip = at < 0 ? length : length + it->delimiter.length;
+  }
+
+  *token = (String){length, it->rest.data};
+  it->rest.data += skip;
+  it->rest.length -= skip;
+  return true;
+}
+
+StringVector StrSplitView(String string, String delimiter) {
+  StringVector result = {0};
+  StrSplitIter it = StrSplitBegin(string, delimiter);
+  for (String token; StrSplitNext(&it, &token);) {
+    VecPush(result, token);
+  }
+  return result;
+}
+
+/* Case flips XOR 0x20 into every byte of the 26 letter range starting at `lo`, 'a' to upper case
+   and 'A' to lower case. Everything below works on whole blocks and leaves the rest to a byte loop */
+static inline uint64_t __base_ascii_flip_swar(uint64_t x, char lo) {
+  const uint64_t ones = 0x0101010101010101ULL, high = 0x8080808080808080ULL;
+  uint64_t heptets = x & ~high;                     // no carries can cross into the next byte
+  uint64_t at_least_lo = heptets + ones * (uint8_t)(0x80 - lo); // high bit set when byte >= lo
+  uint64_t past_hi = heptets + ones * (uint8_t)(0x80 - lo - 26); // high bit set when byte > lo + 25
+  uint64_t in_range = (at_least_lo ^ past_hi) & ~x & high;
+  return x ^ (in_range >> 2);
+}
+
+#  if defined(BASE_SIMD_AVX2)
+#    define __BASE_ASCII_BLOCK 32
+typedef __m256i __base_ascii_block;
+
+static inline __m256i __base_ascii_load(const char *p) {
+  return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static inline void __base_ascii_store(char *p, __m256i block) {
+  _mm256_storeu_si256((__m256i *)p, block);
+}
+
+static inline __m256i __base_ascii_flip(__m256i x, char lo) {
+  __m256i shifted = _mm256_add_epi8(x, _mm256_set1_epi8((char)(uint8_t)(0x80 - lo))); // `lo` lands on -128
+  __m256i in_range = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), shifted);
+  return _mm256_xor_si256(x, _mm256_and_si256(in_range, _mm256_set1_epi8(0x20)));
+}
+
+static inline bool __base_ascii_eq(__m256i a, __m256i b) {
+  return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) == 0xFFFFFFFFu;
+}
+#  elif defined(BASE_SIMD_SSE2)
+#    define __BASE_ASCII_BLOCK 16
+typedef __m128i __base_ascii_block;
+
+static inline __m128i __base_ascii_load(const char *p) {
+  return _mm_loadu_si128((const __m128i *)p);
+}
+
+static inline void __base_ascii_store(char *p, __m128i block) {
+  _mm_storeu_si128((__m128i *)p, block);
+}
+
+static inline __m128i __base_ascii_flip(__m128i x, char lo) {
+  __m128i shifted = _mm_add_epi8(x, _mm_set1_epi8((char)(uint8_t)(0x80 - lo))); // `lo` lands on -128
+  __m128i in_range = _mm_cmpgt_epi8(_mm_set1_epi8(-128 + 26), shifted);
+  return _mm_xor_si128(x, _mm_and_si128(in_range, _mm_set1_epi8(0x20)));
+}
+
+static inline bool __base_ascii_eq(__m128i a, __m128i b) {
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF;
+}
+#  elif defined(BASE_SIMD_NEON)
+#    define __BASE_ASCII_BLOCK 16
+typedef uint8x16_t __base_ascii_block;
+
+static inline uint8x16_t __base_ascii_load(const char *p) {
+  return vld1q_u8((const uint8_t *)p);
+}
+
+static inline void __base_ascii_store(char *p, uint8x16_t block) {
+  vst1q_u8((uint8_t *)p, block);
+}
+
+static inline uint8x16_t __base_ascii_flip(uint8x16_t x, char lo) {
+  uint8x16_t in_range = vcltq_u8(vsubq_u8(x, vdupq_n_u8((uint8_t)lo)), vdupq_n_u8(26));
+  return veorq_u8(x, vandq_u8(in_range, vdupq_n_u8(0x20)));
+}
+
+static inline bool __base_ascii_eq(uint8x16_t a, uint8x16_t b) {
+  return __base_neon_movemask(vceqq_u8(a, b)) == 0x8888888888888888ULL;
+}
+#  endif
+
+static void __base_ascii_flip_range(char *data, size_t length, char lo) {
+  size_t i = 0;
+#  if defined(__BASE_ASCII_BLOCK)
+  for (; i + __BASE_ASCII_BLOCK <= length; i += __BASE_ASCII_BLOCK) {
+    __base_ascii_store(data + i, __base_ascii_flip(__base_ascii_load(data + i), lo));
+  }
+#  endif
+  for (; i + 8 <= length; i += 8) {
+    uint64_t block;
+    memcpy(&block, data + i, sizeof(block));
+    block = __base_ascii_flip_swar(block, lo);
+    memcpy(data + i, &block, sizeof(block));
+  }
+  for (; i < length; i++) {
+    if ((uint8_t)(data[i] - lo) < 26) data[i] ^= 0x20;
+  }
+}
+
+void StrToUpper(String str) {
+  __base_ascii_flip_range(str.data, str.length, 'a');
+}
+
+void StrToLower(String str) {
+  __base_ascii_flip_range(str.data, str.length, 'A');
+}
+
+bool StrEqIgnoreCase(String a, String b) {
+  if (a.length != b.length) return false;
+
+  size_t i = 0;
+#  if defined(__BASE_ASCII_BLOCK)
+  for (; i + __BASE_ASCII_BLOCK <= a.length; i += __BASE_ASCII_BLOCK) {
+    __base_ascii_block lower_a = __base_ascii_flip(__base_ascii_load(a.data + i), 'A');
+    __base_ascii_block lower_b = __base_ascii_flip(__base_ascii_load(b.data + i), 'A');
+    if (!__base_ascii_eq(lower_a, lower_b)) return false;
+  }
+#  endif
+  for (; i + 8 <= a.length; i += 8) {
+    uint64_t block_a, block_b;
+    memcpy(&block_a, a.data + i, sizeof(block_a));
+    memcpy(&block_b, b.data + i, sizeof(block_b));
+    if (__base_ascii_flip_swar(block_a, 'A') != __base_ascii_flip_swar(block_b, 'A')) return false;
+  }
+  for (; i < a.length; i++) {
+    char lower_a = (uint8_t)(a.data[i] - 'A') < 26 ? a.data[i] ^ 0x20 : a.data[i];
+    char lower_b = (uint8_t)(b.data[i] - 'A') < 26 ? b.data[i] ^ 0x20 : b.data[i];
+    if (lower_a != lower_b) return false;
+  }
+  return true;
+}
+
+// Hashes the lower case copy 256 bytes at a time, chaining each chunk's hash as the next seed
+uint64_t StrHashIgnoreCase(String str) {
+  char lower[256];
+  uint64_t hash = 0;
+  size_t offset = 0;
+  do {
+    size_t length = Min(str.length - offset, sizeof(lower));
+    if (length > 0) memcpy(lower, str.data + offset, length);
+    __base_ascii_flip_range(lower, length, 'A');
+    hash = HashBytes(lower, length, hash);
+    offset += length;
+  } while (offset < str.length);
+  return hash;
+}
+
+bool StrIsNull(String str) {
+  return str.data == NULL;
+}
+
+bool StrIsEmpty(String str) {
+  return str.length == 0;
+}
+
+static bool is_space(char character) {
+  return character == ' ' || character == '\n' || character == '\t' || character == '\r';
+}
+
+void StrTrim(String *str) {
+  if (StrIsEmpty(*str)) {
+    return;
+  }
+
+  String view = StrTrimView(*str);
+  if (view.data != str->data) {
+    memmove(str->data, view.data, view.length);
+  }
+  str->length = view.length;
+  add_null_terminator(str->data, str->length);
+}
+
+String StrTrimView(String str) {
+  size_t start = 0, end = str.length;
+  while (start < end && is_space(str.data[start])) {
+    start++;
+  }
+  while (end > start && is_space(str.data[end - 1])) {
+    end--;
+  }
+  return (String){end - start, str.data + start};
+}
+
+String StrSlice(Arena *arena, String str, size_t start, ssize_t end) {
+  Assert(start <= str.length, "StrSlice: start index out of bounds");
+
+  if (end < 0) {
+    end = str.length + end;
+  }
+
+  Assert(end >= (ssize_t)start, "StrSlice: end must be greater than or equal to start: start=%lu, end=%lu", start, end);
+  Assert(end <= (ssize_t)str.length, "StrSlice: end index out of bounds");
+
+  size_t len = end - start;
+  return StrNewSize(arena, str.data + start, len);
+}
+
+bool StrIncludes(String source, String sub_str) {
+  if (StrIsEmpty(sub_str)) return false;
+  return StrFind(source, sub_str) >= 0;
+}
+
+/* Substring search compares the needle's first and last byte against a whole block of positions
+   at once and only runs memcmp on the ones where both match. Masks have one bit per position,
+   `__BASE_STR_LANE_SHIFT` bits apart */
+#  if defined(BASE_SIMD_AVX2)
+#    define __BASE_STR_LANES 32
+#    define __BASE_STR_LANE_SHIFT 0
+
+static inline uint64_t __base_str_match2(const char *a, const char *b, char first, char last) {
+  __m256i first_eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)a), _mm256_set1_epi8(first));
+  __m256i last_eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)b), _mm256_set1_epi8(last));
+  return (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(first_eq, last_eq));
+}
+#  elif defined(BASE_SIMD_SSE2)
+#    define __BASE_STR_LANES 16
+#    define __BASE_STR_LANE_SHIFT 0
+
+static inline uint64_t __base_str_match2(const char *a, const char *b, char first, char last) {
+  __m128i first_eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)a), _mm_set1_epi8(first));
+  __m128i last_eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)b), _mm_set1_epi8(last));
+  return (uint32_t)_mm_movemask_epi8(_mm_and_si128(first_eq, last_eq));
+}
+#  elif defined(BASE_SIMD_NEON)
+#    define __BASE_STR_LANES 16
+#    define __BASE_STR_LANE_SHIFT 2
+
+static inline uint64_t __base_str_match2(const char *a, const char *b, char first, char last) {
+  uint8x16_t first_eq = vceqq_u8(vld1q_u8((const uint8_t *)a), vdupq_n_u8((uint8_t)first));
+  uint8x16_t last_eq = vceqq_u8(vld1q_u8((const uint8_t *)b), vdupq_n_u8((uint8_t)last));
+  return __base_neon_movemask(vandq_u8(first_eq, last_eq));
+}
+#  else
+#    define __BASE_STR_LANES 8
+#    define __BASE_STR_LANE_SHIFT 3
+
+// SWAR: a byte of `x ^ broadcast(c)` is zero where it matched, its high bit ends up set
+static inline uint64_t __base_str_zero_bytes(uint64_t x) {
+  return ~(((x & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | x | 0x7F7F7F7F7F7F7F7FULL);
+}
+
+static inline uint64_t __base_str_match2(const char *a, const char *b, char first, char last) {
+  uint64_t block_a, block_b;
+  memcpy(&block_a, a, sizeof(block_a));
+  memcpy(&block_b, b, sizeof(block_b));
+#    if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  block_a = __builtin_bswap64(block_a); // lane 0 must be the low byte
+  block_b = __builtin_bswap64(block_b);
+#    endif
+  uint64_t first_eq = __base_str_zero_bytes(block_a ^ (0x0101010101010101ULL * (uint8_t)first));
+  uint64_t last_eq = __base_str_zero_bytes(block_b ^ (0x0101010101010101ULL * (uint8_t)last));
+  return first_eq & last_eq;
+}
+#  endif
+
+ssize_t StrFind(String haystack, String needle) {
+  if (needle.length == 0) return 0;
+  if (needle.length > haystack.length) return -1;
+  if (needle.length == 1) return StrFindChar(haystack, needle.data[0]);
+
+  const char *h = haystack.data;
+  const char first = needle.data[0], last = needle.data[needle.length - 1];
+  const size_t positions = haystack.length - needle.length + 1;
+  size_t i = 0;
+  for (; i + __BASE_STR_LANES <= positions; i += __BASE_STR_LANES) {
+    uint64_t mask = __base_str_match2(h + i, h + i + needle.length - 1, first, last);
+    for (; mask; mask &= mask - 1) {
+      size_t candidate = i + (__base_ctz64(mask) >> __BASE_STR_LANE_SHIFT);
+      if (memcmp(h + candidate + 1, needle.data + 1, needle.length - 2) == 0) return (ssize_t)candidate;
+    }
+  }
+
+  for (; i < positions; i++) {
+    if (h[i] == first && h[i + needle.length - 1] == last && memcmp(h + i + 1, needle.data + 1, needle.length - 2) == 0) {
+      return (ssize_t)i;
+    }
+  }
+  return -1;
+}
+
+ssize_t StrFindLast(String haystack, String needle) {
+  if (needle.length == 0) return (ssize_t)haystack.length;
+  if (needle.length > haystack.length) return -1;
+
+  const char *h = haystack.data;
+  const char first = needle.data[0], last = needle.data[needle.length - 1];
+  size_t end = haystack.length - needle.length + 1; // positions left to check are [0, end)
+  while (end >= __BASE_STR_LANES) {
+    size_t start = end - __BASE_STR_LANES;
+    uint64_t mask = __base_str_match2(h + start, h + start + needle.length - 1, first, last);
+    while (mask) {
+      uint32_t bit = 63 - __base_clz64(mask);
+      size_t candidate = start + (bit >> __BASE_STR_LANE_SHIFT);
+      if (needle.length == 1 || memcmp(h + candidate + 1, needle.data + 1, needle.length - 2) == 0) return (ssize_t)candidate;
+      mask ^= 1ULL << bit;
+    }
+    end = start;
+  }
+
+  while (end-- > 0) {
+    if (h[end] == first && h[end + needle.length - 1] == last && (needle.length == 1 || memcmp(h + end + 1, needle.data + 1, needle.length - 2) == 0)) {
+      return (ssize_t)end;
+    }
+  }
+  return -1;
+}
+
+ssize_t StrFindChar(String string, char c) {
+  if (string.length == 0) return -1;
+  const char *match = memchr(string.data, c, string.length); // libc's memchr is already vectorized
+  return match ? match - string.data : -1;
+}
+
+StringBuilder SBCreate(Arena *arena) {
+  return SBReserve(arena, 128);
+}
+
+StringBuilder SBReserve(Arena *arena, size_t capacity) {
+  StringBuilder result = SBReserveWith(ArenaAllocator(arena), capacity);
+  result.arena_builder = arena;
+  return result;
+}
+
+StringBuilder SBCreateWith(Allocator allocator) {
+  return SBReserveWith(allocator, 128);
+}
+
+StringBuilder SBReserveWith(Allocator allocator, size_t capacity) {
+  StringBuilder result = {0};
+  capacity = Max(capacity, (size_t)1); // always room for the null terminator
+  char *data = AllocatorAlloc(allocator, capacity, 1);
+  data[0] = '\0';
+
+  result.allocator = allocator;
+  result.capacity = capacity;
+  result.buffer = (String){.data = data, .length = 0};
+  return result;
+}
+
+StringBuilder SBCreateChunked(Arena *arena) {
+  StringBuilder result = SBCreateChunkedWith(ArenaAllocator(arena), 0);
+  result.arena_builder = arena;
+  return result;
 }
 
-String StrConcat(Arena *arena, String string1, String string2) {
-  if (StrIsNull(string1)) {
-    size_t len = string2.length;
-    size_t memory_size = sizeof(char) * len + 1;
-    char *allocated_string = ArenaAllocChars(arena, memory_size);
+StringBuilder SBCreateChunkedWith(Allocator allocator, size_t chunk_size) {
+  return (StringBuilder){.allocator = allocator, .chunk_size = chunk_size ? chunk_size : SB_CHUNK_SIZE};
+}
 
-    errno_t err = memcpy_s(allocated_string, memory_size, string2.data, string2.length);
-    Assert(err == SUCCESS, "StrConcat: memcpy_s failed, err: %d", err);
+// Builders set up by hand with only the deprecated `arena_builder` keep allocating from that arena
+static Allocator __base_sb_allocator(StringBuilder *builder) {
+  if (builder->allocator.alloc == NULL && builder->arena_builder != NULL) return ArenaAllocator(builder->arena_builder);
+  return builder->allocator;
+}
 
-    add_null_terminator(allocated_string, len);
-    return (String){len, allocated_string};
+void SBFree(StringBuilder *builder) {
+  Allocator allocator = __base_sb_allocator(builder);
+  if (builder->chunk_size != 0) {
+    for (__SBChunk *chunk = builder->head, *next; chunk != NULL; chunk = next) {
+      next = chunk->next;
+      AllocatorFree(allocator, chunk, sizeof(__SBChunk) + chunk->capacity);
+    }
+  } else {
+    AllocatorFree(allocator, builder->buffer.data, builder->capacity);
   }
+  *builder = (StringBuilder){0};
+}
 
-  if (StrIsNull(string2)) {
-    size_t len = string1.length;
-    size_t memory_size = sizeof(char) * len + 1;
-    char *allocated_string = ArenaAllocChars(arena, memory_size);
-    errno_t err = memcpy_s(allocated_string, memory_size, string1.data, string1.length);
-    Assert(err == SUCCESS, "StrConcat: memcpy_s failed, err: %d", err);
+// Fills the tail chunk and starts new ones as needed, a string bigger than a chunk gets a chunk of its own size
+static void __base_sb_add_chunked(StringBuilder *builder, String string) {
+  size_t offset = 0;
+  while (offset < string.length) {
+    __SBChunk *tail = builder->tail;
+    if (tail == NULL || tail->length == tail->capacity) {
+      size_t capacity = Max(builder->chunk_size, string.length - offset);
+      __SBChunk *chunk = AllocatorAlloc(__base_sb_allocator(builder), sizeof(__SBChunk) + capacity, DEFAULT_ALIGNMENT);
+      *chunk = (__SBChunk){.capacity = capacity};
+      if (tail != NULL) tail->next = chunk;
+      else              builder->head = chunk;
+      builder->tail = tail = chunk;
+    }
 
-    add_null_terminator(allocated_string, len);
-    return (String){len, allocated_string};
+    size_t count = Min(tail->capacity - tail->length, string.length - offset);
+    memcpy(tail->data + tail->length, string.data + offset, count);
+    tail->length += count;
+    offset += count;
   }
+  builder->total_length += string.length;
+}
 
-  size_t len = string1.length + string2.length;
-  size_t memory_size = sizeof(char) * len + 1;
-  char *allocated_string = ArenaAllocChars(arena, memory_size);
-
-  errno_t err = memcpy_s(allocated_string, memory_size, string1.data, string1.length);
-  Assert(err == SUCCESS, "StrConcat: memcpy_s failed, err: %d", err);
+size_t SBLength(StringBuilder *builder) {
+  return builder->chunk_size != 0 ? builder->total_length : builder->buffer.length;
+}
 
-  err = memcpy_s(allocated_string + string1.length, memory_size, string2.data, string2.length);
-  Assert(err == SUCCESS, "StrConcat: memcpy_s failed, err: %d", err);
+String SBToString(Arena *arena, StringBuilder *builder) {
+  if (builder->chunk_size == 0) return builder->buffer;
 
-  add_null_terminator(allocated_string, len);
-  return (String){len, allocated_string};
+  char *data = ArenaAllocNoZero(arena, builder->total_length + 1);
+  size_t offset = 0;
+  for (__SBChunk *chunk = builder->head; chunk != NULL; chunk = chunk->next) {
+    memcpy(data + offset, chunk->data, chunk->length);
+    offset += chunk->length;
+  }
+  data[offset] = '\0';
+  return (String){.length = offset, .data = data};
 }
 
-StringVector StrSplit(Arena *arena, String str, String delimiter) {
-  StringVector result = {0};
-  if (StrIsEmpty(str)) {
-    return result;
+// Flat builders only: room for `count` more bytes plus the null terminator
+static void sb_ensure_free(StringBuilder *builder, size_t count) {
+  size_t new_len = builder->buffer.length + count;
+  if (new_len + 1 >= builder->capacity) {
+    size_t new_cap = (new_len + 1) * 2;
+    char *data = AllocatorResize(__base_sb_allocator(builder), builder->buffer.data, builder->capacity, new_cap, 1);
+    builder->buffer.data = data;
+    builder->capacity = new_cap;
   }
+}
 
-  char *start = str.data;
-  char *end = str.data + str.length;
-  char *curr = start;
-  if (StrIsEmpty(delimiter)) {
-    for (size_t i = 0; i < str.length; i++) {
-      String curr_str = StrNewSize(arena, str.data + i, 1);
-      VecPush(result, curr_str);
-    }
-    return result;
+void SBAdd(StringBuilder *builder, String string) {
+  if (builder->chunk_size != 0) {
+    __base_sb_add_chunked(builder, string);
+    return;
   }
 
-  while (curr < end) {
-    char *match = NULL;
-    for (char *search = curr; search <= end - delimiter.length; search++) {
-      if (memcmp(search, delimiter.data, delimiter.length) == 0) {
-        match = search;
-        break;
-      }
-    }
-
-    if (!match) {
-      String curr_str = StrNewSize(arena, curr, end - curr);
-      VecPush(result, curr_str);
-      break;
-    }
+  sb_ensure_free(builder, string.length);
+  memcpy(builder->buffer.data + builder->buffer.length, string.data, string.length);
+  builder->buffer.length += string.length;
+  builder->buffer.data[builder->buffer.length] = '\0';
+}
 
-    size_t len = match - curr;
-    String curr_str = StrNewSize(arena, curr, len);
-    VecPush(result, curr_str);
+static const char __base_digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
 
-    curr = match + delimiter.length;
-  }
+static const uint64_t __base_pow10_u64[20] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL};
 
-  return result;
+static inline size_t __base_count_digits(uint64_t value) {
+  if (value < 10) return 1;
+  uint32_t guess = (64 - __base_clz64(value)) * 1233 >> 12; // bits * log10(2), at most one short
+  return guess + (value >= __base_pow10_u64[guess]);
 }
 
-void StrToUpper(String str) {
-  for (size_t i = 0; i < str.length; ++i) {
-    char curr_char = str.data[i];
-    str.data[i] = toupper(curr_char);
+/* Counts the digits first so they can be written straight to their final place, two per division */
+static size_t u64_to_chars(char *out, uint64_t value) {
+  size_t length = __base_count_digits(value);
+  char *p = out + length;
+  while (value >= 100) {
+    p -= 2;
+    memcpy(p, __base_digit_pairs + (value % 100) * 2, 2);
+    value /= 100;
   }
-}
-
-void StrToLower(String str) {
-  for (size_t i = 0; i < str.length; ++i) {
-    char curr_char = str.data[i];
-    str.data[i] = tolower(curr_char);
+  if (value >= 10) {
+    memcpy(p - 2, __base_digit_pairs + value * 2, 2);
+  } else {
+    p[-1] = (char)('0' + value);
   }
+  return length;
 }
 
-bool StrIsNull(String str) {
-  return str.data == NULL;
+static size_t i64_to_chars(char *out, int64_t value) {
+  if (value >= 0) return u64_to_chars(out, (uint64_t)value);
+  *out = '-';
+  return 1 + u64_to_chars(out + 1, -(uint64_t)value);
 }
 
-bool StrIsEmpty(String str) {
-  return str.length == 0;
+String StrFromU64(Arena *arena, uint64_t value) {
+  char *data = ArenaAllocCharsNoZero(arena, __base_count_digits(value) + 1);
+  size_t length = u64_to_chars(data, value);
+  add_null_terminator(data, length);
+  return (String){length, data};
 }
 
-static bool is_space(char character) {
-  return character == ' ' || character == '\n' || character == '\t' || character == '\r';
+String StrFromI64(Arena *arena, int64_t value) {
+  char *data = ArenaAllocCharsNoZero(arena, __base_count_digits(value < 0 ? -(uint64_t)value : (uint64_t)value) + 2);
+  size_t length = i64_to_chars(data, value);
+  add_null_terminator(data, length);
+  return (String){length, data};
 }
 
-void StrTrim(String *str) {
-  if (StrIsEmpty(*str)) {
+void SBAddU64(StringBuilder *builder, uint64_t value) {
+  if (builder->chunk_size != 0) { // may straddle two chunks, so it goes through SBAdd
+    char tmp[20];
+    SBAdd(builder, (String){u64_to_chars(tmp, value), tmp});
     return;
   }
 
-  size_t start = 0;
-  while (start < str->length && is_space(str->data[start])) {
-    start++;
-  }
+  sb_ensure_free(builder, 20);
+  builder->buffer.length += u64_to_chars(builder->buffer.data + builder->buffer.length, value);
+  builder->buffer.data[builder->buffer.length] = '\0';
+}
 
-  if (start == str->length) {
-    add_null_terminator(str->data, 0);
-    str->length = 0;
+void SBAddI64(StringBuilder *builder, int64_t value) {
+  if (builder->chunk_size != 0) {
+    char tmp[21];
+    SBAdd(builder, (String){i64_to_chars(tmp, value), tmp});
     return;
   }
 
-  size_t end = str->length - 1;
-  while (end > start && is_space(str->data[end])) {
-    end--;
-  }
+  sb_ensure_free(builder, 21);
+  builder->buffer.length += i64_to_chars(builder->buffer.data + builder->buffer.length, value);
+  builder->buffer.data[builder->buffer.length] = '\0';
+}
 
-  str->length = end - start + 1;
-  if (start > 0) {
-    memmove(str->data, &str->data[start], str->length);
-  }
-  add_null_terminator(str->data, str->length);
+// SWAR: true when all eight bytes are '0'..'9'
+static inline bool __base_is_eight_digits(uint64_t block) {
+  return (((block & 0xF0F0F0F0F0F0F0F0ULL) | (((block + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+          0x3333333333333333ULL);
 }
 
-String StrSlice(Arena *arena, String str, size_t start, ssize_t end) {
-  Assert(start <= str.length, "StrSlice: start index out of bounds");
+// SWAR: value of eight digit bytes, the first one most significant, in three multiplies
+static inline uint32_t __base_parse_eight_digits(uint64_t block) {
+  block -= 0x3030303030303030ULL;
+  block = (block * 10) + (block >> 8);
+  block = (((block & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+           (((block >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+  return (uint32_t)block;
+}
 
-  if (end < 0) {
-    end = str.length + end;
+/* Consumes the digits at `str.data[start]`, eight at a time while the result cannot overflow.
+   Keeps consuming after an overflow so the error is not mistaken for trailing characters */
+static size_t __base_parse_digits(String str, size_t start, uint64_t *value, bool *overflow) {
+  size_t i = start;
+  uint64_t result = 0;
+  while (i + 8 <= str.length && i - start <= 11) { // under 10^11 before, so under 10^19 after
+    uint64_t block;
+    memcpy(&block, str.data + i, sizeof(block));
+#  if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    block = __builtin_bswap64(block); // the first digit must be the low byte
+#  endif
+    if (!__base_is_eight_digits(block)) break;
+    result = result * 100000000 + __base_parse_eight_digits(block);
+    i += 8;
   }
+  for (; i < str.length && str.data[i] >= '0' && str.data[i] <= '9'; i++) {
+    uint64_t digit = (uint64_t)(str.data[i] - '0');
+    if (result > (UINT64_MAX - digit) / 10) *overflow = true;
+    else                                     result = result * 10 + digit;
+  }
+  *value = *overflow ? UINT64_MAX : result;
+  return i - start;
+}
 
-  Assert(end >= (ssize_t)start, "StrSlice: end must be greater than or equal to start: start=%lu, end=%lu", start, end);
-  Assert(end <= (ssize_t)str.length, "StrSlice: end index out of bounds");
+ParseU64Result StrParseU64(String str) {
+  ParseU64Result result = {0};
+  size_t start = (str.length > 0 && str.data[0] == '+') ? 1 : 0;
+  bool overflow = false;
+  size_t digits = __base_parse_digits(str, start, &result.data, &overflow);
 
-  size_t len = end - start;
-  return StrNewSize(arena, str.data + start, len);
+  if (digits == 0)                          result.error = PARSE_INVALID;
+  else if (overflow)                        result.error = PARSE_OVERFLOW;
+  else if (start + digits < str.length)     result.error = PARSE_TRAILING_CHARS;
+  return result;
 }
 
-bool StrIncludes(String source, String sub_str) {
-  if (StrIsEmpty(source) || StrIsEmpty(sub_str) || sub_str.length > source.length) {
-    return false;
+ParseI64Result StrParseI64(String str) {
+  ParseI64Result result = {0};
+  bool negative = str.length > 0 && str.data[0] == '-';
+  size_t start = (str.length > 0 && (str.data[0] == '-' || str.data[0] == '+')) ? 1 : 0;
+  bool overflow = false;
+  uint64_t magnitude;
+  size_t digits = __base_parse_digits(str, start, &magnitude, &overflow);
+
+  uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+  if (magnitude > limit) {
+    overflow = true;
+    magnitude = limit;
+  }
+  result.data = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+
+  if (digits == 0)                          result.error = PARSE_INVALID;
+  else if (overflow)                        result.error = PARSE_OVERFLOW;
+  else if (start + digits < str.length)     result.error = PARSE_TRAILING_CHARS;
+  return result;
+}
+
+static const float64_t __base_pow10_f64[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                             1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/* Clinger's fast path: a mantissa below 2^53 and a power of ten up to 10^22 are both exact doubles,
+   so one correctly rounded multiply or divide gives the correctly rounded result. Everything else
+   (more than 19 significant digits, larger exponents) goes to strtod on a copy of the digits */
+ParseF64Result StrParseF64(String str) {
+  ParseF64Result result = {0};
+  size_t i = 0;
+  bool negative = str.length > 0 && str.data[0] == '-';
+  if (str.length > 0 && (str.data[0] == '-' || str.data[0] == '+')) i++;
+
+  String rest = {str.length - i, str.data + i};
+  if (StrEqIgnoreCase(rest, S("inf")) || StrEqIgnoreCase(rest, S("infinity"))) {
+    result.data = negative ? -HUGE_VAL : HUGE_VAL;
+    return result;
+  }
+  if (StrEqIgnoreCase(rest, S("nan"))) {
+    result.data = negative ? -NAN : NAN;
+    return result;
   }
 
-  for (size_t i = 0; i <= source.length - sub_str.length; i++) {
-    if (source.data[i] != sub_str.data[0]) {
+  uint64_t mantissa = 0;
+  int64_t exponent = 0;
+  size_t significant = 0, digits = 0;
+  for (bool fraction = false; i < str.length; i++) {
+    char c = str.data[i];
+    if (c == '.' && !fraction) {
+      fraction = true;
       continue;
     }
+    if (c < '0' || c > '9') break;
 
-    if (memcmp(&source.data[i], sub_str.data, sub_str.length) == 0) {
-      return true;
+    digits++;
+    if (mantissa == 0 && c == '0') {
+      exponent -= fraction; // leading zeros only move the point
+      continue;
     }
+    if (significant < 19) mantissa = mantissa * 10 + (uint64_t)(c - '0');
+    else if (!fraction)   exponent++;
+    significant++;
+    exponent -= fraction;
+  }
+  if (digits == 0) {
+    result.error = PARSE_INVALID;
+    return result;
   }
 
-  return false;
-}
+  size_t end = i;
+  if (i < str.length && (str.data[i] == 'e' || str.data[i] == 'E')) {
+    size_t j = i + 1;
+    bool negative_exponent = j < str.length && str.data[j] == '-';
+    if (j < str.length && (str.data[j] == '-' || str.data[j] == '+')) j++;
+    int64_t explicit_exponent = 0;
+    size_t exponent_start = j;
+    for (; j < str.length && str.data[j] >= '0' && str.data[j] <= '9'; j++) {
+      if (explicit_exponent < 100000) explicit_exponent = explicit_exponent * 10 + (str.data[j] - '0');
+    }
+    if (j > exponent_start) { // a bare 'e' is left as a trailing character
+      exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+      end = j;
+    }
+  }
 
-StringBuilder SBCreate(Arena *arena) {
-  StringBuilder result = {0};
-  char *data = ArenaAllocChars(arena, 128);
+  float64_t value;
+  if (mantissa == 0) {
+    value = 0.0;
+  } else if (FLT_EVAL_METHOD == 0 && significant <= 19 && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+    value = exponent < 0 ? (float64_t)mantissa / __base_pow10_f64[-exponent] : (float64_t)mantissa * __base_pow10_f64[exponent];
+  } else {
+    size_t start = negative || str.data[0] == '+' ? 1 : 0;
+    size_t length = end - start;
+    char stack_copy[128];
+    char *copy = length < sizeof(stack_copy) ? stack_copy : Malloc(length + 1);
+    memcpy(copy, str.data + start, length);
+    copy[length] = '\0';
+    value = strtod(copy, NULL);
+    if (copy != stack_copy) Free(copy);
+  }
 
-  result.arena_builder = arena;
-  result.capacity = 128;
-  result.buffer = (String){.data = data, .length = 0};
+  result.data = negative ? -value : value;
+  if (value == HUGE_VAL)      result.error = PARSE_OVERFLOW;
+  else if (end < str.length)  result.error = PARSE_TRAILING_CHARS;
   return result;
 }
 
-StringBuilder SBReserve(Arena *arena, size_t capacity) {
-  StringBuilder result = {0};
-  char *data = ArenaAllocChars(arena, capacity);
+static String string_from_hex(char *buf, size_t buff_size, uint64_t value, bool upper) {
+  const char *hex_digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+  char *end = buf + buff_size;
+  char *p = end;
+  *--p = '\0';
 
-  result.arena_builder = arena;
-  result.capacity = capacity;
-  result.buffer = (String){.data = data, .length = 0};
-  return result;
+  do {
+    *--p = hex_digits[value & 0xF];
+    value >>= 4;
+  } while (value > 0);
+
+  return (String){.data = p, .length = (size_t)(end - p - 1)};
 }
 
-void SBAdd(StringBuilder *builder, String string) {
-  size_t new_len = builder->buffer.length + string.length;
-  if (new_len + 1 >= builder->capacity) {
-    size_t new_cap = (new_len + 1) * 2;
-    char *data = ArenaAllocChars(builder->arena_builder, new_cap);
+/* Grisu2 (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers") on a 64 bit
+   "do it yourself" float: the digits always round-trip and are the shortest ones for almost every double */
+typedef struct {
+  uint64_t f;
+  int32_t e;
+} __BaseDiyFp;
+
+// Normalized 10^k for k = -348, -340, ..., 340
+static const __BaseDiyFp __base_cached_powers[] = {
+  {0xfa8fd5a0081c0288ULL, -1220}, {0xbaaee17fa23ebf76ULL, -1193}, {0x8b16fb203055ac76ULL, -1166},
+  {0xcf42894a5dce35eaULL, -1140}, {0x9a6bb0aa55653b2dULL, -1113}, {0xe61acf033d1a45dfULL, -1087},
+  {0xab70fe17c79ac6caULL, -1060}, {0xff77b1fcbebcdc4fULL, -1034}, {0xbe5691ef416bd60cULL, -1007},
+  {0x8dd01fad907ffc3cULL, -980}, {0xd3515c2831559a83ULL, -954}, {0x9d71ac8fada6c9b5ULL, -927},
+  {0xea9c227723ee8bcbULL, -901}, {0xaecc49914078536dULL, -874}, {0x823c12795db6ce57ULL, -847},
+  {0xc21094364dfb5637ULL, -821}, {0x9096ea6f3848984fULL, -794}, {0xd77485cb25823ac7ULL, -768},
+  {0xa086cfcd97bf97f4ULL, -741}, {0xef340a98172aace5ULL, -715}, {0xb23867fb2a35b28eULL, -688},
+  {0x84c8d4dfd2c63f3bULL, -661}, {0xc5dd44271ad3cdbaULL, -635}, {0x936b9fcebb25c996ULL, -608},
+  {0xdbac6c247d62a584ULL, -582}, {0xa3ab66580d5fdaf6ULL, -555}, {0xf3e2f893dec3f126ULL, -529},
+  {0xb5b5ada8aaff80b8ULL, -502}, {0x87625f056c7c4a8bULL, -475}, {0xc9bcff6034c13053ULL, -449},
+  {0x964e858c91ba2655ULL, -422}, {0xdff9772470297ebdULL, -396}, {0xa6dfbd9fb8e5b88fULL, -369},
+  {0xf8a95fcf88747d94ULL, -343}, {0xb94470938fa89bcfULL, -316}, {0x8a08f0f8bf0f156bULL, -289},
+  {0xcdb02555653131b6ULL, -263}, {0x993fe2c6d07b7facULL, -236}, {0xe45c10c42a2b3b06ULL, -210},
+  {0xaa242499697392d3ULL, -183}, {0xfd87b5f28300ca0eULL, -157}, {0xbce5086492111aebULL, -130},
+  {0x8cbccc096f5088ccULL, -103}, {0xd1b71758e219652cULL, -77}, {0x9c40000000000000ULL, -50},
+  {0xe8d4a51000000000ULL, -24}, {0xad78ebc5ac620000ULL, 3}, {0x813f3978f8940984ULL, 30},
+  {0xc097ce7bc90715b3ULL, 56}, {0x8f7e32ce7bea5c70ULL, 83}, {0xd5d238a4abe98068ULL, 109},
+  {0x9f4f2726179a2245ULL, 136}, {0xed63a231d4c4fb27ULL, 162}, {0xb0de65388cc8ada8ULL, 189},
+  {0x83c7088e1aab65dbULL, 216}, {0xc45d1df942711d9aULL, 242}, {0x924d692ca61be758ULL, 269},
+  {0xda01ee641a708deaULL, 295}, {0xa26da3999aef774aULL, 322}, {0xf209787bb47d6b85ULL, 348},
+  {0xb454e4a179dd1877ULL, 375}, {0x865b86925b9bc5c2ULL, 402}, {0xc83553c5c8965d3dULL, 428},
+  {0x952ab45cfa97a0b3ULL, 455}, {0xde469fbd99a05fe3ULL, 481}, {0xa59bc234db398c25ULL, 508},
+  {0xf6c69a72a3989f5cULL, 534}, {0xb7dcbf5354e9beceULL, 561}, {0x88fcf317f22241e2ULL, 588},
+  {0xcc20ce9bd35c78a5ULL, 614}, {0x98165af37b2153dfULL, 641}, {0xe2a0b5dc971f303aULL, 667},
+  {0xa8d9d1535ce3b396ULL, 694}, {0xfb9b7cd9a4a7443cULL, 720}, {0xbb764c4ca7a44410ULL, 747},
+  {0x8bab8eefb6409c1aULL, 774}, {0xd01fef10a657842cULL, 800}, {0x9b10a4e5e9913129ULL, 827},
+  {0xe7109bfba19c0c9dULL, 853}, {0xac2820d9623bf429ULL, 880}, {0x80444b5e7aa7cf85ULL, 907},
+  {0xbf21e44003acdd2dULL, 933}, {0x8e679c2f5e44ff8fULL, 960}, {0xd433179d9c8cb841ULL, 986},
+  {0x9e19db92b4e31ba9ULL, 1013}, {0xeb96bf6ebadf77d9ULL, 1039}, {0xaf87023b9bf0ee6bULL, 1066},
+};
+
+static const uint32_t __base_pow10_u32[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+static __BaseDiyFp __base_diyfp_mul(__BaseDiyFp x, __BaseDiyFp y) {
+  const uint64_t low = 0xFFFFFFFFULL;
+  uint64_t a = x.f >> 32, b = x.f & low, c = y.f >> 32, d = y.f & low;
+  uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+  uint64_t middle = (bd >> 32) + (ad & low) + (bc & low) + (1ULL << 31); // rounds the dropped low half
+  return (__BaseDiyFp){ac + (ad >> 32) + (bc >> 32) + (middle >> 32), x.e + y.e + 64};
+}
 
-    memcpy(data, builder->buffer.data, builder->buffer.length);
-    builder->buffer.data = data;
-    builder->capacity = new_cap;
+static void __base_grisu_round(char *digits, int32_t length, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t distance) {
+  while (rest < distance && delta - rest >= ten_kappa &&
+         (rest + ten_kappa < distance || distance - rest > rest + ten_kappa - distance)) {
+    digits[length - 1]--;
+    rest += ten_kappa;
   }
+}
 
-  memcpy(builder->buffer.data + builder->buffer.length, string.data, string.length);
-  builder->buffer.length = new_len;
-  builder->buffer.data[builder->buffer.length] = '\0';
+// Digits of a finite `value` > 0 without trailing zeros, the value is digits * 10^exponent
+static int32_t __base_grisu2(double value, char *digits, int32_t *exponent) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const uint64_t hidden = 1ULL << 52;
+  int32_t biased = (int32_t)((bits >> 52) & 0x7FF);
+  uint64_t fraction = bits & (hidden - 1);
+  __BaseDiyFp v = biased != 0 ? (__BaseDiyFp){fraction + hidden, biased - 1075} : (__BaseDiyFp){fraction, -1074};
+
+  // Halfway points to the neighbouring doubles, both on the exponent of the normalized upper one
+  __BaseDiyFp plus = {(v.f << 1) + 1, v.e - 1};
+  int32_t shift = (int32_t)__base_clz64(plus.f);
+  plus = (__BaseDiyFp){plus.f << shift, plus.e - shift};
+  __BaseDiyFp minus = v.f == hidden ? (__BaseDiyFp){(v.f << 2) - 1, v.e - 2} : (__BaseDiyFp){(v.f << 1) - 1, v.e - 1};
+  minus = (__BaseDiyFp){minus.f << (minus.e - plus.e), plus.e};
+  shift = (int32_t)__base_clz64(v.f);
+  v = (__BaseDiyFp){v.f << shift, v.e - shift};
+
+  // Cached power that brings the upper bound's binary exponent into [-60, -32]
+  double dk = (-61 - plus.e) * 0.30102999566398114 + 347;
+  int32_t k = (int32_t)dk;
+  if (dk - k > 0.0) k++;
+  uint32_t index = (uint32_t)((k >> 3) + 1);
+  *exponent = 348 - (int32_t)(index << 3);
+
+  __BaseDiyFp cached = __base_cached_powers[index];
+  __BaseDiyFp w = __base_diyfp_mul(v, cached);
+  __BaseDiyFp upper = __base_diyfp_mul(plus, cached);
+  __BaseDiyFp lower = __base_diyfp_mul(minus, cached);
+  upper.f--;
+  lower.f++;
+
+  // Emits digits of `upper` until the remainder fits in the rounding interval
+  int32_t one_shift = -upper.e;
+  uint64_t one = 1ULL << one_shift;
+  uint64_t delta = upper.f - lower.f;
+  uint64_t distance = upper.f - w.f;
+  uint32_t p1 = (uint32_t)(upper.f >> one_shift);
+  uint64_t p2 = upper.f & (one - 1);
+  int32_t kappa = 1;
+  while (kappa < 10 && p1 >= __base_pow10_u32[kappa]) {
+    kappa++;
+  }
+
+  int32_t length = 0;
+  while (kappa > 0) {
+    uint32_t digit = p1 / __base_pow10_u32[kappa - 1];
+    p1 %= __base_pow10_u32[kappa - 1];
+    if (digit || length) digits[length++] = (char)('0' + digit);
+    kappa--;
+    uint64_t rest = ((uint64_t)p1 << one_shift) + p2;
+    if (rest <= delta) {
+      *exponent += kappa;
+      __base_grisu_round(digits, length, delta, rest, (uint64_t)__base_pow10_u32[kappa] << one_shift, distance);
+      goto strip;
+    }
+  }
+  for (;;) {
+    p2 *= 10;
+    delta *= 10;
+    char digit = (char)(p2 >> one_shift);
+    if (digit || length) digits[length++] = (char)('0' + digit);
+    p2 &= one - 1;
+    kappa--;
+    if (p2 < delta) {
+      *exponent += kappa;
+      __base_grisu_round(digits, length, delta, p2, one, distance * (-kappa < 9 ? __base_pow10_u32[-kappa] : 0));
+      break;
+    }
+  }
+
+strip:
+  while (length > 1 && digits[length - 1] == '0') {
+    length--;
+    (*exponent)++;
+  }
+  return length;
 }
 
-static String string_from_u64(char *buf, size_t buff_size, uint64_t value) {
-  char *end = buf + buff_size;
-  char *p = end;
-  *--p = '\0';
+// Rounds 0.digits * 10^point half up to `keep` digits, an all zero result becomes "0" with point 1
+static int32_t __base_round_digits(char *digits, int32_t length, int32_t *point, int32_t keep) {
+  if (keep >= length) return length;
 
-  if (value == 0) {
-    *--p = '0';
-  } else {
-    while (value > 0) {
-      *--p = '0' + (int32_t)(value % 10);
-      value /= 10;
+  bool round_up = keep >= 0 && digits[keep] >= '5';
+  length = Max(keep, 0);
+  if (round_up) {
+    while (length > 0 && digits[length - 1] == '9') {
+      length--;
     }
+    if (length == 0) {
+      digits[length++] = '1';
+      (*point)++;
+    } else {
+      digits[length - 1]++;
+    }
+  }
+  if (length == 0) {
+    digits[length++] = '0';
+    *point = 1;
   }
+  return length;
+}
 
-  return (String){.data = p, .length = (size_t)(end - p - 1)};
+static char *__base_write_fixed(char *p, const char *digits, int32_t length, int32_t point, int32_t fraction) {
+  if (point <= 0) {
+    *p++ = '0';
+  }
+  for (int32_t i = 0; i < point; i++) {
+    *p++ = i < length ? digits[i] : '0';
+  }
+  if (fraction > 0) {
+    *p++ = '.';
+    for (int32_t i = point; i < point + fraction; i++) {
+      *p++ = (i >= 0 && i < length) ? digits[i] : '0';
+    }
+  }
+  return p;
 }
 
-static String string_from_i64(char *buf, size_t buff_size, int64_t value) {
-  int32_t neg = value < 0;
-  uint64_t abs = neg ? -(uint64_t)value : (uint64_t)value;
+static char *__base_write_scientific(char *p, const char *digits, int32_t length, int32_t exponent) {
+  *p++ = digits[0];
+  if (length > 1) {
+    *p++ = '.';
+    memcpy(p, digits + 1, (size_t)length - 1);
+    p += length - 1;
+  }
+  *p++ = 'e';
+  *p++ = exponent < 0 ? '-' : '+';
+  exponent = exponent < 0 ? -exponent : exponent;
+  if (exponent >= 100) *p++ = (char)('0' + exponent / 100);
+  *p++ = (char)('0' + exponent / 10 % 10);
+  *p++ = (char)('0' + exponent % 10);
+  return p;
+}
 
-  char *end = buf + buff_size;
-  char *p = end;
-  *--p = '\0';
+/* %f is fixed notation, %g is fixed unless the exponent is below -4 or reaches 21 (or the precision).
+   Without a precision the shortest round-trip digits are printed, with one those digits are rounded
+   half up, so 2.675 prints as 2.68 where printf, rounding the binary value, gives 2.67 */
+static String string_from_f64(char *buf, double value, char spec, int32_t precision) {
+  char *p = buf;
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if (((bits >> 52) & 0x7FF) == 0x7FF) {
+    if (bits & ((1ULL << 52) - 1)) return S("nan");
+    return (bits >> 63) ? S("-inf") : S("inf");
+  }
+  if (bits >> 63) {
+    *p++ = '-';
+    value = -value;
+  }
 
-  if (abs == 0) {
-    *--p = '0';
+  char digits[32];
+  int32_t exponent = 0, length = 1;
+  if (value == 0) digits[0] = '0';
+  else            length = __base_grisu2(value, digits, &exponent);
+  int32_t point = length + exponent; // the value is 0.digits * 10^point
+
+  if (spec == 'f') {
+    if (precision >= 0) length = __base_round_digits(digits, length, &point, point + precision);
+    p = __base_write_fixed(p, digits, length, point, precision >= 0 ? precision : Max(length - point, 0));
   } else {
-    while (abs > 0) {
-      *--p = '0' + (int)(abs % 10);
-      abs /= 10;
+    int32_t limit = 21;
+    if (precision >= 0) {
+      limit = Max(precision, 1);
+      length = __base_round_digits(digits, length, &point, limit);
+      while (length > 1 && digits[length - 1] == '0') {
+        length--;
+      }
     }
+    if (value != 0 && (point - 1 < -4 || point - 1 >= limit)) p = __base_write_scientific(p, digits, length, point - 1);
+    else                                                       p = __base_write_fixed(p, digits, length, point, Max(length - point, 0));
   }
-  if (neg) *--p = '-';
 
-  return (String){.data = p, .length = (size_t)(end - p - 1)};
+  *p = '\0';
+  return (String){.data = buf, .length = (size_t)(p - buf)};
+}
+
+static void sb_add_padding(StringBuilder *builder, char fill, size_t count) {
+  char block[32];
+  memset(block, fill, sizeof(block));
+  while (count > 0) {
+    size_t length = Min(count, sizeof(block));
+    SBAdd(builder, (String){.data = block, .length = length});
+    count -= length;
+  }
 }
 
-/* Format specifiers:
+/* Format specifiers, each may start with flags `-` (left align) and `0` (zero pad numbers), a width
+*  and, for %f and %g, a `.precision`, e.g. %-8S %08x %10.3f:
 *  %s  — char * (null terminated)
 *  %S  — String
+*  %c  — char
 *  %d  — i32
 *  %l  — i64
 *  %ud — u32
 *  %ul — u64
+*  %x  — u32 as lower case hex, %X upper case
+*  %lx — u64 as lower case hex, %lX upper case
+*  %p  — void * as 0x prefixed hex
+*  %f  — double in fixed notation
+*  %g  — double in fixed or scientific notation, whichever the exponent calls for
 */
 void SBAddFormatV(StringBuilder *builder, char *fmt, va_list args) {
   char *cursor = fmt;
@@ -1339,54 +4755,128 @@ void SBAddFormatV(StringBuilder *builder, char *fmt, va_list args) {
     }
     cursor++;
 
+    bool left_align = false, zero_pad = false;
+    for (;; cursor++) {
+      if (*cursor == '-')      left_align = true;
+      else if (*cursor == '0') zero_pad = true;
+      else                     break;
+    }
+    size_t width = 0;
+    while (*cursor >= '0' && *cursor <= '9') {
+      width = width * 10 + (size_t)(*cursor++ - '0');
+    }
+    int32_t precision = -1;
+    if (*cursor == '.') {
+      cursor++;
+      precision = 0;
+      while (*cursor >= '0' && *cursor <= '9') {
+        precision = precision * 10 + (*cursor++ - '0');
+      }
+      Assert(precision <= 128, "SBAddFormatV: precision is limited to 128 digits");
+    }
+
     bool is_unsigned = false;
     if (*cursor == 'u') {
       is_unsigned = true;
       cursor++;
     }
 
-    char tmp[32];
+    char tmp[512];
     String segment = {0};
+    size_t prefix = 0;      // sign or 0x that zero padding goes after
+    bool is_number = false; // only numbers are zero padded
 
-    switch (*cursor++) {
+    char spec = *cursor++;
+    Assert(precision < 0 || spec == 'f' || spec == 'g', "SBAddFormatV: precision is only valid for %%f and %%g");
+    Assert(!is_unsigned || spec == 'd' || spec == 'l', "SBAddFormatV: u is only valid before d and l");
+    switch (spec) {
     case 's': {
-      Assert(!is_unsigned, "%%us is not a valid specifier");
       char *str = va_arg(args, char *);
       Assert(str != NULL, "str should never be NULL");
       segment = (String){.data = (char *)str, .length = strlen(str)};
     } break;
     case 'S': {
-      Assert(!is_unsigned, "%%uS is not a valid specifier");
       segment = va_arg(args, String);
       Assert(!StrIsNull(segment), "String should never be NULL");
     } break;
+    case 'c': {
+      tmp[0] = (char)va_arg(args, int);
+      segment = (String){.data = tmp, .length = 1};
+    } break;
     case 'd': {
-      if (is_unsigned) {
-        uint32_t v = va_arg(args, uint32_t);
-        segment = string_from_u64(tmp, sizeof(tmp), (uint64_t)v);
-      } else {
-        int32_t v = va_arg(args, int32_t);
-        segment = string_from_i64(tmp, sizeof(tmp), (int64_t)v);
+      int64_t v = is_unsigned ? (int64_t)va_arg(args, uint32_t) : (int64_t)va_arg(args, int32_t);
+      if (width == 0) {
+        SBAddI64(builder, v);
+        continue;
       }
+      segment = (String){.data = tmp, .length = i64_to_chars(tmp, v)};
+      is_number = true;
     } break;
     case 'l': {
-      if (is_unsigned) {
+      if (*cursor == 'x' || *cursor == 'X') {
+        Assert(!is_unsigned, "%%ulx is not a valid specifier, %%lx is already unsigned");
+        uint64_t v = va_arg(args, uint64_t);
+        segment = string_from_hex(tmp, sizeof(tmp), v, *cursor++ == 'X');
+      } else if (is_unsigned) {
         uint64_t v = va_arg(args, uint64_t);
-        segment = string_from_u64(tmp, sizeof(tmp), (uint64_t)v);
+        if (width == 0) {
+          SBAddU64(builder, v);
+          continue;
+        }
+        segment = (String){.data = tmp, .length = u64_to_chars(tmp, v)};
       } else {
         int64_t v = va_arg(args, int64_t);
-        segment = string_from_i64(tmp, sizeof(tmp), v);
+        if (width == 0) {
+          SBAddI64(builder, v);
+          continue;
+        }
+        segment = (String){.data = tmp, .length = i64_to_chars(tmp, v)};
       }
+      is_number = true;
+    } break;
+    case 'x':
+    case 'X': {
+      uint32_t v = va_arg(args, uint32_t);
+      segment = string_from_hex(tmp, sizeof(tmp), (uint64_t)v, spec == 'X');
+      is_number = true;
+    } break;
+    case 'p': {
+      uintptr_t v = (uintptr_t)va_arg(args, void *);
+      segment = string_from_hex(tmp, sizeof(tmp), (uint64_t)v, false);
+      *--segment.data = 'x';
+      *--segment.data = '0';
+      segment.length += 2;
+      prefix = 2;
+      is_number = true;
+    } break;
+    case 'f':
+    case 'g': {
+      segment = string_from_f64(tmp, va_arg(args, double), spec, precision);
+      is_number = segment.data == tmp; // nan and inf are padded with spaces
     } break;
     case '%': {
-      Assert(!is_unsigned, "%%u%% is not a valid specifier");
       segment = (String){.data = "%", .length = 1};
     } break;
     default:
       Unreachable("SBAddFormatV: unknown format specifier");
     }
 
-    if (segment.length > 0) {
+    if (segment.length >= width) {
+      if (segment.length > 0) SBAdd(builder, segment);
+      continue;
+    }
+
+    size_t padding = width - segment.length;
+    if (left_align) {
+      SBAdd(builder, segment);
+      sb_add_padding(builder, ' ', padding);
+    } else if (zero_pad && is_number) {
+      if (segment.data[0] == '-') prefix = 1;
+      SBAdd(builder, (String){.data = segment.data, .length = prefix});
+      sb_add_padding(builder, '0', padding);
+      SBAdd(builder, (String){.data = segment.data + prefix, .length = segment.length - prefix});
+    } else {
+      sb_add_padding(builder, ' ', padding);
       SBAdd(builder, segment);
     }
   }
@@ -1399,6 +4889,43 @@ void SBAddF(StringBuilder *builder, char *fmt, ...) {
     va_end(args);
 }
 
+InternTable *InternTableCreate(void) {
+  InternTable *table = Malloc(sizeof(InternTable));
+  *table = (InternTable){.arena = ArenaCreate(ARENA_COMMIT_SIZE)};
+  return table;
+}
+
+void InternTableFree(InternTable *table) {
+  HashMapFree(table->ids);
+  VecFree(table->strings);
+  ArenaFree(table->arena);
+  Free(table);
+}
+
+InternId StrIntern(InternTable *table, String string) {
+  InternId *id = HashMapEntry(table->ids, string);
+  if (*id != 0) return *id;
+
+  // New entry: the map still points at the caller's bytes, swap them for the arena copy
+  String copy = StrNewSize(table->arena, string.data, string.length);
+  table->ids.keys[id - table->ids.values] = copy;
+  VecPush(table->strings, copy);
+
+  Assert(table->strings.length <= UINT32_MAX, "StrIntern: ran out of ids");
+  *id = (InternId)table->strings.length;
+  return *id;
+}
+
+InternId StrInternFind(InternTable *table, String string) {
+  InternId *id = HashMapGet(table->ids, string);
+  return id ? *id : 0;
+}
+
+String InternGet(InternTable *table, InternId id) {
+  Assert(id > 0 && id <= table->strings.length, "InternGet: invalid id %u", id);
+  return table->strings.data[id - 1];
+}
+
 /*   }}} --- Random Implementations --- {{{   */
 static uint64_t seed = 0;
 
@@ -1490,7 +5017,7 @@ FileStatsResult FileStats(String path) {
   return result;
 }
 
-FileReadResult FileRead(Arena *arena, String path, size_t file_size) {
+FileReadResult FileReadWith(Allocator allocator, String path, size_t file_size) {
   FileReadResult result = {0};
   HANDLE hFile = CreateFileA(path.data, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
   if (hFile == INVALID_HANDLE_VALUE) {
@@ -1498,7 +5025,7 @@ FileReadResult FileRead(Arena *arena, String path, size_t file_size) {
     return result;
   }
 
-  char *buffer = ArenaAllocChars(arena, file_size + 1);
+  char *buffer = AllocatorAlloc(allocator, file_size + 1, 1);
   DWORD bytes_read;
   if (!ReadFile(hFile, buffer, (DWORD)file_size, &bytes_read, NULL)) {
     result.error = ErrnoMatch(GetLastError());
@@ -1508,6 +5035,7 @@ FileReadResult FileRead(Arena *arena, String path, size_t file_size) {
     buffer[bytes_read] = '\0';
     result.data = (String){.data = buffer, .length = (size_t)bytes_read};
   }
+  if (result.error != SUCCESS) AllocatorFree(allocator, buffer, file_size + 1);
   CloseHandle(hFile);
   return result;
 }
@@ -1540,6 +5068,34 @@ Error FileAdd(String path, String data) {
   return err;
 }
 
+Error SBWriteToFile(StringBuilder *builder, String path) {
+  if (builder->chunk_size == 0) return FileWrite(path, builder->buffer);
+
+  HANDLE hFile = CreateFileA(path.data, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (hFile == INVALID_HANDLE_VALUE) return ErrnoMatch(GetLastError());
+
+  // WriteFile may take less than asked, keep going from where it stopped
+  Error err = SUCCESS;
+  for (__SBChunk *chunk = builder->head; chunk != NULL && err == SUCCESS; chunk = chunk->next) {
+    size_t written = 0;
+    while (written < chunk->length) {
+      DWORD bytes_written;
+      DWORD count = (DWORD)Min(chunk->length - written, (size_t)MAXDWORD);
+      if (!WriteFile(hFile, chunk->data + written, count, &bytes_written, NULL)) {
+        err = ErrnoMatch(GetLastError());
+        break;
+      }
+      if (bytes_written == 0) {
+        err = FILE_WRITE_FAILED;
+        break;
+      }
+      written += bytes_written;
+    }
+  }
+  CloseHandle(hFile);
+  return err;
+}
+
 Error FileDelete(String path) {
   if (!DeleteFileA(path.data)) return ErrnoMatch(GetLastError());
   return SUCCESS;
@@ -1673,7 +5229,7 @@ FileStatsResult FileStats(String path) {
   return result;
 }
 
-FileReadResult FileRead(Arena *arena, String path, size_t file_size) {
+FileReadResult FileReadWith(Allocator allocator, String path, size_t file_size) {
   FileReadResult result = {0};
   int fd = open(path.data, O_RDONLY);
   if (fd < 0) {
@@ -1681,7 +5237,7 @@ FileReadResult FileRead(Arena *arena, String path, size_t file_size) {
     return result;
   }
 
-  char *buffer = ArenaAllocChars(arena, file_size + 1);
+  char *buffer = AllocatorAlloc(allocator, file_size + 1, 1);
   ssize_t bytes_read = read(fd, buffer, file_size);
   if (bytes_read < 0) {
     result.error = ErrnoMatch(errno);
@@ -1691,6 +5247,7 @@ FileReadResult FileRead(Arena *arena, String path, size_t file_size) {
     buffer[bytes_read] = '\0';
     result.data = (String){.length = bytes_read, .data = buffer};
   }
+  if (result.error != SUCCESS) AllocatorFree(allocator, buffer, file_size + 1);
   close(fd);
   return result;
 }
@@ -1725,6 +5282,51 @@ Error FileAdd(String path, String data) {
   return err;
 }
 
+/* Hands up to 64 chunks to each writev call, picks up mid chunk after a short write and retries
+   when a signal interrupts the call */
+Error SBWriteToFile(StringBuilder *builder, String path) {
+  if (builder->chunk_size == 0) return FileWrite(path, builder->buffer);
+
+  int fd = open(path.data, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return ErrnoMatch(errno);
+  }
+
+  Error err = SUCCESS;
+  __SBChunk *chunk = builder->head;
+  size_t written_in_chunk = 0;
+  while (chunk != NULL) {
+    struct iovec iov[64];
+    int count = 0;
+    for (__SBChunk *it = chunk; it != NULL && count < 64; it = it->next, count++) {
+      size_t skip = it == chunk ? written_in_chunk : 0;
+      iov[count] = (struct iovec){.iov_base = it->data + skip, .iov_len = it->length - skip};
+    }
+
+    ssize_t bytes_written = writev(fd, iov, count);
+    if (bytes_written < 0 && errno == EINTR) continue;
+    if (bytes_written < 0) {
+      err = ErrnoMatch(errno);
+      break;
+    }
+    if (bytes_written == 0) {
+      err = FILE_WRITE_FAILED;
+      break;
+    }
+
+    size_t left = (size_t)bytes_written;
+    while (chunk != NULL && left >= chunk->length - written_in_chunk) {
+      left -= chunk->length - written_in_chunk;
+      written_in_chunk = 0;
+      chunk = chunk->next;
+    }
+    written_in_chunk += left;
+  }
+
+  close(fd);
+  return err;
+}
+
 Error FileDelete(String path) {
   if (unlink(path.data) != SUCCESS) return ErrnoMatch(errno);
   return SUCCESS;
@@ -1819,6 +5421,10 @@ Error FileCopy(String sourcePath, String destPath) {
 }
 #  endif
 
+FileReadResult FileRead(Arena *arena, String path, size_t file_size) {
+  return FileReadWith(ArenaAllocator(arena), path, file_size);
+}
+
 /*   }}} --- Logger Implementations --- {{{   */
 void LogInit(void) {
 #  if defined(BASE_PLATFORM_WIN)
@@ -1996,14 +5602,16 @@ int32_t IniGetInt(IniFile *ini_file, String key) {
     return 0;
   }
 
-  char *end_ptr;
-  int32_t result = (int32_t)strtol(value.data, &end_ptr, 10);
-  if (end_ptr == value.data) {
-    LogWarn("IniGetInt: Failed to convert [key: %s, value: %s] to int", key.data, value.data);
-    return 0;
+  ParseI64Result result = StrParseI64(StrTrimView(value));
+  if (result.error == SUCCESS && (result.data < INT32_MIN || result.data > INT32_MAX)) {
+    result.error = PARSE_OVERFLOW;
+  }
+  if (result.error != SUCCESS) {
+    LogWarn("IniGetInt: Failed to convert [key: %s, value: %s] to int, %s", key.data, value.data, ErrToStr(result.error).data);
   }
 
-  return result;
+  // Out of range values clamp instead of wrapping, trailing characters keep the leading number
+  return (int32_t)Max(Min(result.data, (int64_t)INT32_MAX), (int64_t)INT32_MIN);
 }
 
 int64_t IniGetLong(IniFile *ini_file, String key) {
@@ -2012,14 +5620,12 @@ int64_t IniGetLong(IniFile *ini_file, String key) {
     return 0;
   }
 
-  char *end_ptr;
-  int64_t result = strtoll(value.data, &end_ptr, 10);
-  if (end_ptr == value.data) {
-    LogWarn("IniGetLong: Failed to convert [key: %s, value: %s] to long", key.data, value.data);
-    return 0;
+  ParseI64Result result = StrParseI64(StrTrimView(value));
+  if (result.error != SUCCESS) {
+    LogWarn("IniGetLong: Failed to convert [key: %s, value: %s] to long, %s", key.data, value.data, ErrToStr(result.error).data);
   }
 
-  return result;
+  return result.data;
 }
 
 float64_t IniGetDouble(IniFile *ini_file, String key) {
@@ -2028,14 +5634,12 @@ float64_t IniGetDouble(IniFile *ini_file, String key) {
     return 0.0;
   }
 
-  char *end_ptr;
-  float64_t result = strtod(value.data, &end_ptr);
-  if (end_ptr == value.data) {
-    LogWarn("IniGetDouble: Failed to convert [key: %s, value: %s] to double", key.data, value.data);
-    return 0.0;
+  ParseF64Result result = StrParseF64(StrTrimView(value));
+  if (result.error != SUCCESS) {
+    LogWarn("IniGetDouble: Failed to convert [key: %s, value: %s] to double, %s", key.data, value.data, ErrToStr(result.error).data);
   }
 
-  return result;
+  return result.data;
 }
 
 bool IniGetBool(IniFile *ini_file, String key) {
@@ -7,6 +7,8 @@ TESTS=(
   "vector-tests"
   "ini-parser-tests"
   "file-system-tests"
+  "alloc-tracking-tests"
+  "hashmap-tests"
 )
 
 if [ $# -lt 1 ]; then
@@ -50,7 +52,7 @@ for test in "${TESTS[@]}"; do
   EXTRA_FLAGS="-Wno-unused-function -fno-omit-frame-pointer -fno-optimize-sibling-calls -Wshadow -Wstrict-prototypes -Wnull-dereference -Wformat=2"
   FANALYZER_FLAGS="-fanalyzer -fanalyzer-call-summaries --param=analyzer-max-recursion-depth=2 --param=analyzer-max-infeasible-edges=2"
 
-  if ! "$COMPILER" $FLAGS $EXTRA_FLAGS "${test}.c" -o "${test}${EXE}" -lm; then
+  if ! "$COMPILER" $FLAGS $EXTRA_FLAGS "${test}.c" -o "${test}${EXE}" -lm -lpthread; then
     echo "Compilation of $test failed"
     cleanup
     exit 1
@@ -0,0 +1,98 @@
+#define BASE_TRACK_ALLOC
+#include "test-framework.c"
+
+static void TestGlobalCounters(void) {
+  TEST_BEGIN("Global Allocation Counters");
+  {
+    AllocStats before = GetAllocStats();
+    char *block = Malloc(100);
+    block = Realloc(block, 300);
+
+    AllocStats during = GetAllocStats();
+    TEST_ASSERT(during.mallocs == before.mallocs + 1, "Malloc is counted");
+    TEST_ASSERT(during.reallocs == before.reallocs + 1, "Realloc is counted");
+    TEST_ASSERT(during.live_bytes == before.live_bytes + 300, "Live bytes follow the realloc");
+    TEST_ASSERT(during.live_blocks == before.live_blocks + 1, "Realloc keeps a single live block");
+    TEST_ASSERT(during.peak_live_bytes >= during.live_bytes, "Peak is at least the live bytes");
+
+    Free(block);
+    AllocStats after = GetAllocStats();
+    TEST_ASSERT(after.frees == before.frees + 1, "Free is counted");
+    TEST_ASSERT(after.live_bytes == before.live_bytes, "Free releases the live bytes");
+
+    Free(NULL);
+    TEST_ASSERT(GetAllocStats().frees == after.frees, "Free(NULL) is a no-op and is not counted");
+
+    char *fresh = Realloc(NULL, 16);
+    TEST_ASSERT(GetAllocStats().live_blocks == after.live_blocks + 1, "Realloc(NULL) tracks a new block");
+    Free(fresh);
+  }
+  {
+    VEC_TYPE(IntVector, int32_t);
+    IntVector numbers = {0};
+    AllocStats before = GetAllocStats();
+    for (int32_t i = 0; i < 1000; i++) {
+      VecPush(numbers, i);
+    }
+    AllocStats after = GetAllocStats();
+    TEST_ASSERT(after.reallocs - before.reallocs == 4, "Vector growth reallocs are counted (128 -> 1024)");
+    VecFree(numbers);
+    TEST_ASSERT(GetAllocStats().live_bytes == before.live_bytes, "VecFree releases the tracked block");
+  }
+  {
+    VEC_TYPE(IntVector, int32_t);
+    HASHMAP_TYPE(IntMap, int32_t, int32_t);
+    IntVector numbers = {0};
+    IntMap map = {0};
+    uint32_t push_line = __LINE__ + 1;
+    VecPush(numbers, 1);
+    uint32_t put_line = __LINE__ + 1;
+    HashMapPut(map, 1, 2);
+
+    __AllocSite *push_site = &__base_alloc_sites[((__AllocHeader *)numbers.data - 1)->site];
+    __AllocSite *put_site = &__base_alloc_sites[((__AllocHeader *)map.ctrl - 1)->site];
+    TEST_ASSERT(push_site->line == push_line && strcmp(push_site->file, FILE_NAME) == 0, "VecPush growth is bucketed at the caller");
+    TEST_ASSERT(put_site->line == put_line && strcmp(put_site->file, FILE_NAME) == 0, "HashMapPut growth is bucketed at the caller");
+    VecFree(numbers);
+    HashMapFree(map);
+  }
+  TEST_END();
+}
+
+static void TestArenaStats(void) {
+  TEST_BEGIN("Arena Stats");
+  {
+    Arena *arena = ArenaCreate(256);
+    ArenaAlloc(arena, 100);
+    ArenaAlloc(arena, 200);
+    ArenaAlloc(arena, 300);
+
+    ArenaStats stats = ArenaGetStats(arena);
+    TEST_ASSERT(stats.allocations == 3, "Arena allocations are counted");
+    TEST_ASSERT(stats.allocated == 600, "Arena bytes are counted");
+    TEST_ASSERT(stats.chunks == 3, "Arena chunks are counted");
+    TEST_ASSERT(stats.capacity >= 600, "Arena capacity covers the allocations");
+
+    ArenaTemp temp = ArenaTempBegin(arena);
+    ArenaAlloc(arena, 1000);
+    ArenaTempEnd(temp);
+    stats = ArenaGetStats(arena);
+    TEST_ASSERT(stats.in_use == 600, "TempEnd rolls back the bytes in use");
+    TEST_ASSERT(stats.peak == 1600, "Peak remembers the temp allocation");
+
+    ArenaReset(arena);
+    stats = ArenaGetStats(arena);
+    TEST_ASSERT(stats.in_use == 0 && stats.allocated == 1600, "Reset clears the bytes in use only");
+    ArenaFree(arena);
+  }
+  TEST_END();
+}
+
+int main(void) {
+  StartTest();
+  {
+    TestGlobalCounters();
+    TestArenaStats();
+  }
+  EndTest();
+}
@@ -150,6 +150,353 @@ static void TestEdgeCaseChunkSizes(void) {
     void *huge_ptr = ArenaAlloc(huge, 1024 * 1024); // 1MB allocation
     TEST_ASSERT(huge_ptr != NULL, "Large allocation in huge arena");
     ArenaFree(huge);
+
+    // The chunk header keeps the buffer aligned, so a full chunk fits without padding
+    Arena *exact = ArenaCreate(1024);
+    void *exact_ptr = ArenaAlloc(exact, 1024);
+    TEST_ASSERT(sizeof(__ArenaChunk) % DEFAULT_ALIGNMENT == 0, "Chunk header is a multiple of DEFAULT_ALIGNMENT");
+    TEST_ASSERT(((uintptr_t)exact_ptr % DEFAULT_ALIGNMENT) == 0, "Chunk buffer is aligned to DEFAULT_ALIGNMENT");
+    TEST_ASSERT(exact->current == exact->root, "chunk_size bytes fit in a fresh arena's first chunk");
+    ArenaFree(exact);
+  }
+  TEST_END();
+}
+
+static void TestArenaReserved(void) {
+  TEST_BEGIN("Reserved Arena Test");
+  {
+    Arena *a = ArenaCreateReserved((size_t)1024 * 1024 * 1024); // 1GB of address space
+    TEST_ASSERT(a != NULL, "Reserved arena created");
+    TEST_ASSERT(a->committed == ARENA_COMMIT_SIZE, "Only the first block is committed");
+
+    char *first = ArenaAllocChars(a, 1024 * 1024);
+    char *second = ArenaAllocChars(a, 8 * 1024 * 1024);
+    TEST_ASSERT(second == first + 1024 * 1024, "Growth stays contiguous");
+    TEST_ASSERT(a->root == a->current && a->root->next == NULL, "Reserved arena never chains chunks");
+    second[8 * 1024 * 1024 - 1] = 'x';
+    TEST_ASSERT(a->committed >= 9 * 1024 * 1024, "Pages get committed on demand");
+
+    ArenaReset(a);
+    TEST_ASSERT(a->committed >= 9 * 1024 * 1024, "Reset keeps the pages the last cycle used");
+    char *after_reset = ArenaAllocChars(a, 64);
+    TEST_ASSERT(after_reset == first, "Reset returned to the beginning of the arena");
+
+    ArenaReset(a);
+    TEST_ASSERT(a->committed == ARENA_COMMIT_SIZE, "Reset decommits pages past the high-water mark");
+
+    char *recommitted = ArenaAllocChars(a, 2 * 1024 * 1024);
+    TEST_ASSERT(recommitted[2 * 1024 * 1024 - 1] == 0, "Recommitted memory is zeroed");
+
+    ArenaFree(a);
+  }
+  TEST_END();
+}
+
+static void TestArenaTemp(void) {
+  TEST_BEGIN("Arena Temp Test");
+  {
+    Arena *a = ArenaCreate(256);
+    char *kept = ArenaAllocChars(a, 100);
+
+    ArenaTemp temp = ArenaTempBegin(a);
+    char *scratch = ArenaAllocChars(a, 100);
+    for (int i = 0; i < 10; i++) {
+      ArenaAlloc(a, 200); // spill into new chunks
+    }
+    TEST_ASSERT(a->current != a->root, "Temp allocations moved to another chunk");
+
+    ArenaTempEnd(temp);
+    TEST_ASSERT(a->current == a->root && a->offset == 100, "TempEnd rolled back to the marker");
+    TEST_ASSERT(ArenaAllocChars(a, 100) == scratch, "Memory after the marker is reused");
+    TEST_ASSERT(kept != NULL, "Memory before the marker is untouched");
+
+    ArenaFree(a);
+  }
+  {
+    Arena *a = ArenaCreate(256);
+    ArenaTemp scratch = ScratchBegin(&a, 1);
+    TEST_ASSERT(scratch.arena != a, "Scratch arena does not alias the caller arena");
+
+    ArenaTemp nested = ScratchBegin(&scratch.arena, 1);
+    TEST_ASSERT(nested.arena != scratch.arena, "Nested scratch picks a different arena");
+    ScratchEnd(nested);
+
+    size_t offset = scratch.arena->offset;
+    ArenaAlloc(scratch.arena, 64);
+    ScratchEnd(scratch);
+    TEST_ASSERT(scratch.arena->offset == offset, "ScratchEnd rolls back the scratch arena");
+
+    ScratchFree();
+    ArenaFree(a);
+  }
+  TEST_END();
+}
+
+static void TestArenaNoZero(void) {
+  TEST_BEGIN("Arena No Zero Test");
+  {
+    Arena *a = ArenaCreate(256);
+    ArenaTemp temp = ArenaTempBegin(a);
+    memset(ArenaAllocChars(a, 64), 'x', 64);
+    ArenaTempEnd(temp);
+
+    char *raw = ArenaAllocCharsNoZero(a, 64);
+    TEST_ASSERT(raw[0] == 'x' && raw[63] == 'x', "NoZero allocation skips the memset");
+    ArenaTempEnd(temp);
+
+    char *zeroed = ArenaAllocChars(a, 64);
+    TEST_ASSERT(zeroed[0] == 0 && zeroed[63] == 0, "Regular allocation is still zeroed");
+    ArenaFree(a);
+  }
+  {
+    Arena *a = ArenaCreateReserved(16 * 1024 * 1024);
+    ArenaTemp temp = ArenaTempBegin(a);
+    memset(ArenaAllocNoZero(a, 4096), 'x', 4096);
+    ArenaTempEnd(temp);
+
+    char *reused = ArenaAlloc(a, 8192);
+    TEST_ASSERT(reused[0] == 0 && reused[4095] == 0, "Dirty part of a reserved arena gets zeroed");
+    TEST_ASSERT(a->dirty == a->offset, "Fresh pages extend the dirty mark without a memset");
+    ArenaFree(a);
+  }
+  TEST_END();
+}
+
+static size_t FreeListBytes(Arena *a) {
+  size_t total = 0;
+  for (__ArenaChunk *chunk = a->free_list; chunk; chunk = chunk->next) {
+    total += chunk->cap;
+  }
+  return total;
+}
+
+static void TestArenaChunkRecycling(void) {
+  TEST_BEGIN("Arena Chunk Recycling Test");
+  {
+    Arena *a = ArenaCreate(256);
+    ArenaAlloc(a, 200);
+    ArenaAlloc(a, 200); // regular chunk
+    ArenaAlloc(a, 8192); // oversized chunk from an unusually large frame
+    ArenaReset(a);
+    TEST_ASSERT(a->root->next == NULL, "Reset moves every chunk past the root to the free list");
+    TEST_ASSERT(a->free_list->cap < a->free_list->next->cap, "Free list is sorted by capacity");
+
+    ArenaAlloc(a, 200);
+    ArenaAlloc(a, 200);
+    TEST_ASSERT(a->current->cap < 8192, "Small allocation picks the best fitting chunk");
+    ArenaFree(a);
+  }
+  {
+    Arena *a = ArenaCreate(256);
+    ArenaSetRetention(a, 1024, 0);
+    ArenaAlloc(a, 200);
+    ArenaAlloc(a, 200);
+    ArenaAlloc(a, 8192);
+    ArenaReset(a);
+    TEST_ASSERT(FreeListBytes(a) <= 1024, "Reset frees chunks above the retained bytes");
+    TEST_ASSERT(a->free_list != NULL, "Small chunks within the budget are kept");
+    ArenaFree(a);
+  }
+  {
+    Arena *a = ArenaCreate(256);
+    ArenaSetRetention(a, SIZE_MAX, 2);
+    ArenaAlloc(a, 200);
+    ArenaAlloc(a, 200);
+    ArenaReset(a);
+    TEST_ASSERT(a->free_list != NULL, "Chunk used in the last cycle is kept");
+    ArenaReset(a);
+    TEST_ASSERT(a->free_list != NULL, "Chunk idle for one reset is kept");
+    ArenaReset(a);
+    TEST_ASSERT(a->free_list == NULL, "Chunk idle for max_idle_resets is freed");
+    ArenaFree(a);
+  }
+  TEST_END();
+}
+
+#define WORKER_COUNT 4
+#define WORKER_ALLOCS 10000
+
+static void *SharedArenaWorker(void *arg) {
+  SharedArena *shared = arg;
+  size_t failures = 0;
+  uint64_t *blocks[WORKER_ALLOCS];
+  for (size_t i = 0; i < WORKER_ALLOCS; i++) {
+    blocks[i] = SharedArenaAlloc(shared, 2 * sizeof(uint64_t));
+    if (blocks[i][0] != 0 || blocks[i][1] != 0) failures++;
+    blocks[i][0] = (uint64_t)(uintptr_t)arg ^ i;
+    blocks[i][1] = i;
+  }
+
+  for (size_t i = 0; i < WORKER_ALLOCS; i++) {
+    if (blocks[i][0] != ((uint64_t)(uintptr_t)arg ^ i) || blocks[i][1] != i) failures++;
+  }
+  return (void *)(uintptr_t)failures;
+}
+
+static void *ThreadArenaWorker(void *arg) {
+  Arena *arena = ThreadArena();
+  if (arena == arg) return NULL; // got the main thread's arena, thread locals are shared
+  for (size_t i = 0; i < 100; i++) {
+    memset(ArenaAlloc(arena, 4096), 0xAB, 4096); // spans several pooled chunks
+  }
+  ArenaReset(arena);
+  ThreadArenaRelease();
+  return arena;
+}
+
+static void TestConcurrentArenas(void) {
+  TEST_BEGIN("Concurrent Arenas Test");
+  {
+    SharedArena *shared = SharedArenaCreate(64 * 1024 * 1024);
+    Thread threads[WORKER_COUNT];
+    for (size_t i = 0; i < WORKER_COUNT; i++) {
+      threads[i] = ThreadCreate(SharedArenaWorker, shared);
+    }
+
+    size_t failures = 0;
+    for (size_t i = 0; i < WORKER_COUNT; i++) {
+      failures += (size_t)(uintptr_t)ThreadJoin(threads[i]);
+    }
+    TEST_ASSERT(failures == 0, "Shared arena hands out zeroed, non overlapping blocks");
+    TEST_ASSERT(shared->offset >= WORKER_COUNT * WORKER_ALLOCS * 2 * sizeof(uint64_t), "Every allocation bumped the shared offset");
+
+    size_t committed = shared->committed;
+    SharedArenaReset(shared);
+    TEST_ASSERT(shared->committed == committed, "Reset keeps the pages the last cycle used committed");
+    uint64_t *after_reset = SharedArenaAlloc(shared, sizeof(uint64_t));
+    TEST_ASSERT(*after_reset == 0 && (char *)after_reset == shared->base, "Reset starts over with zeroed memory");
+    uint64_t *block = SharedArenaAlloc(shared, WORKER_ALLOCS * sizeof(uint64_t));
+    bool zeroed = true;
+    for (size_t i = 0; i < WORKER_ALLOCS; i++) {
+      zeroed = zeroed && block[i] == 0;
+    }
+    TEST_ASSERT(zeroed, "Kept pages come back zeroed");
+
+    SharedArenaReset(shared);
+    TEST_ASSERT(shared->committed < committed, "Pages the last cycle did not use are decommitted");
+    SharedArenaFree(shared);
+  }
+  {
+    Arena *arena = ThreadArena();
+    Thread threads[WORKER_COUNT];
+    for (size_t i = 0; i < WORKER_COUNT; i++) {
+      threads[i] = ThreadCreate(ThreadArenaWorker, arena);
+    }
+
+    for (size_t i = 0; i < WORKER_COUNT; i++) {
+      TEST_ASSERT(ThreadJoin(threads[i]) != NULL, "Worker got its own thread arena");
+    }
+
+    TEST_ASSERT(arena == ThreadArena(), "Thread arena is reused within a thread");
+    TEST_ASSERT(arena->pooled && arena->root->cap == ARENA_POOL_CHUNK_SIZE, "Thread arena chunks come from the pool");
+    ThreadArenaRelease();
+    TEST_ASSERT(__base_chunk_pool_count > 0 && __base_chunk_pool_count <= ARENA_POOL_MAX_CHUNKS, "Released chunks are pooled up to the cap");
+
+    ThreadArenaPoolTrim(1);
+    TEST_ASSERT(__base_chunk_pool_count == 1, "Trim keeps the requested chunks");
+    ThreadArenaPoolTrim(0);
+    TEST_ASSERT(__base_chunk_pool_count == 0 && __base_chunk_pool == NULL, "Trim to zero empties the pool");
+  }
+  TEST_END();
+}
+
+static void CountTask(void *arg) {
+  AtomicFetchAdd((volatile size_t *)arg, 1);
+}
+
+static void TestThreadPool(void) {
+  TEST_BEGIN("Thread Pool Test");
+  {
+    volatile size_t counter = 0;
+    ThreadPool *pool = ThreadPoolCreate(4);
+    for (size_t round = 1; round <= 3; round++) {
+      for (size_t i = 0; i < 1000; i++) {
+        ThreadPoolSubmit(pool, CountTask, (void *)&counter);
+      }
+      ThreadPoolWait(pool);
+      TEST_ASSERT(AtomicLoad(&counter) == round * 1000, "Wait returns once every task of the round ran");
+    }
+
+    ThreadPoolSubmit(pool, CountTask, (void *)&counter);
+    ThreadPoolDestroy(pool);
+    TEST_ASSERT(counter == 3001, "Destroy drains queued tasks");
+    TEST_ASSERT(ThreadHardwareCount() >= 1, "At least one core is reported");
+  }
+  TEST_END();
+}
+
+typedef struct PoolNode {
+  struct PoolNode *left;
+  struct PoolNode *right;
+  int64_t value;
+} PoolNode;
+
+static void TestPool(void) {
+  TEST_BEGIN("Pool Test");
+  {
+    Pool *pool = PoolCreate(sizeof(PoolNode), 64);
+    TEST_ASSERT(pool->elem_size % 64 == 0, "Element size is rounded up to the alignment");
+
+    PoolNode *nodes[5000];
+    bool aligned = true, zeroed = true;
+    for (size_t i = 0; i < ARR_LEN(nodes); i++) {
+      nodes[i] = PoolAlloc(pool);
+      aligned &= ((uintptr_t)nodes[i] % 64) == 0;
+      zeroed &= nodes[i]->left == NULL && nodes[i]->value == 0;
+      nodes[i]->value = (int64_t)i;
+    }
+    TEST_ASSERT(aligned, "Every object is aligned");
+    TEST_ASSERT(zeroed, "Objects come zeroed");
+    TEST_ASSERT(nodes[4999]->value == 4999 && nodes[0]->value == 0, "Objects across slabs don't overlap");
+
+    PoolFree(pool, nodes[10]);
+    PoolFree(pool, nodes[20]);
+    TEST_ASSERT(PoolAlloc(pool) == nodes[20], "Freed objects are reused, last freed first");
+    TEST_ASSERT(PoolAlloc(pool) == nodes[10], "Free list is walked in order");
+
+    PoolReset(pool);
+    TEST_ASSERT(PoolAlloc(pool) == nodes[0], "Reset starts carving from the first slab again");
+    PoolDestroy(pool);
+  }
+  TEST_END();
+}
+
+static void TestArenaResize(void) {
+  TEST_BEGIN("Arena Resize Test");
+  {
+    Arena *a = ArenaCreate(1024);
+    char *last = ArenaAllocChars(a, 100);
+    memset(last, 'a', 100);
+
+    char *grown = ArenaResize(a, last, 100, 400);
+    TEST_ASSERT(grown == last, "Last allocation grows in place");
+    TEST_ASSERT(a->offset == (size_t)(last - a->current->buffer) + 400, "Offset follows the resize");
+
+    char *shrunk = ArenaResize(a, grown, 400, 200);
+    TEST_ASSERT(shrunk == last && a->offset == (size_t)(last - a->current->buffer) + 200, "Last allocation shrinks in place");
+
+    ArenaAlloc(a, 16);
+    char *moved = ArenaResize(a, shrunk, 200, 300);
+    TEST_ASSERT(moved != shrunk, "Allocation that's not the last one gets copied");
+    TEST_ASSERT(moved[0] == 'a' && moved[99] == 'a', "Copied allocation keeps its contents");
+
+    char *spilled = ArenaResize(a, moved, 300, 4096);
+    TEST_ASSERT(spilled != moved && spilled[99] == 'a', "Allocation that doesn't fit the chunk gets copied");
+
+    ArenaAlloc(a, 16);
+    size_t offset = a->offset;
+    char *kept = ArenaResize(a, spilled, 4096, 1024);
+    TEST_ASSERT(kept == spilled && a->offset == offset, "Shrinking an allocation that's not the last one keeps it in place");
+    ArenaFree(a);
+  }
+  {
+    Arena *a = ArenaCreateReserved(64 * 1024 * 1024);
+    char *data = ArenaAllocChars(a, 16);
+    char *grown = ArenaResize(a, data, 16, 8 * 1024 * 1024);
+    TEST_ASSERT(grown == data, "Reserved arena grows in place");
+    grown[8 * 1024 * 1024 - 1] = 'x';
+    TEST_ASSERT(a->committed >= 8 * 1024 * 1024, "Growing in place commits the pages");
+    ArenaFree(a);
   }
   TEST_END();
 }
@@ -164,6 +511,14 @@ int main(void) {
     TestArenaStress();
     TestZeroSizeAllocations();
     TestEdgeCaseChunkSizes();
+    TestArenaReserved();
+    TestArenaTemp();
+    TestArenaNoZero();
+    TestArenaChunkRecycling();
+    TestConcurrentArenas();
+    TestThreadPool();
+    TestPool();
+    TestArenaResize();
   }
   EndTest();
 }
@@ -33,6 +33,10 @@ static void TestFileOperations(void) {
     }
     TEST_ASSERT(content_match, "read content should match written content");
 
+    FileReadResult heap_read = FileReadWith(HeapAllocator(), S("test-file.txt"), stats.data.size);
+    TEST_ASSERT(heap_read.error == SUCCESS && StrEq(heap_read.data, content), "should read file into the heap");
+    Free(heap_read.data.data);
+
     String additional = S("Additional content");
     TEST_ASSERT(FileAdd(S("test-file.txt"), additional) == SUCCESS, "should add content to file");
 
@@ -240,6 +244,34 @@ static void TestFileCopy(void) {
   TEST_END();
 }
 
+static void TestBuilderToFile(void) {
+  TEST_BEGIN("BuilderToFile");
+  {
+    Arena *arena = ArenaCreate(1024 * 1024);
+    // Tiny chunks so the write needs more than one batch of iovecs
+    StringBuilder builder = SBCreateChunked(arena);
+    builder.chunk_size = 7;
+    for (int32_t i = 0; i < 1000; i++) {
+      SBAddF(&builder, "%d,", i);
+    }
+    TEST_ASSERT(SBWriteToFile(&builder, S("builder-file.txt")) == SUCCESS, "should write chunked builder to file");
+
+    FileReadResult read = FileRead(arena, S("builder-file.txt"), SBLength(&builder));
+    TEST_ASSERT(read.error == SUCCESS, "should read the written file back");
+    TEST_ASSERT(StrEq(read.data, SBToString(arena, &builder)), "file holds every chunk in order");
+
+    StringBuilder flat = SBCreate(arena);
+    SBAddS(&flat, "flat builder");
+    TEST_ASSERT(SBWriteToFile(&flat, S("builder-file.txt")) == SUCCESS, "should write flat builder to file");
+    read = FileRead(arena, S("builder-file.txt"), flat.buffer.length);
+    TEST_ASSERT(read.error == SUCCESS && StrEq(read.data, S("flat builder")), "flat builder is written as is");
+
+    TEST_ASSERT(FileDelete(S("builder-file.txt")) == SUCCESS, "should delete file");
+    ArenaFree(arena);
+  }
+  TEST_END();
+}
+
 int main(void) {
   StartTest();
   {
@@ -249,6 +281,7 @@ int main(void) {
     TestPathHandling();
     TestFileSystemEdgeCases();
     TestFileCopy();
+    TestBuilderToFile();
   }
   EndTest();
 }
@@ -0,0 +1,170 @@
+#include "test-framework.c"
+
+HASHMAP_TYPE(StringIntMap, String, int32_t);
+HASHMAP_TYPE(U64Map, uint64_t, uint64_t);
+
+typedef struct {
+  int32_t x;
+  int32_t y;
+} Point;
+HASHMAP_TYPE(PointMap, Point, String);
+
+static void TestHashing(void) {
+  TEST_BEGIN("Hashing");
+  {
+    TEST_ASSERT(StrHash(S("hello")) == StrHash(S("hello")), "Same string hashes the same");
+    TEST_ASSERT(StrHash(S("hello")) != StrHash(S("hellp")), "One byte changes the hash");
+    TEST_ASSERT(StrHash(S("")) != StrHash(S("a")), "Empty string hashes differently");
+    TEST_ASSERT(HashBytes("abc", 3, 0) != HashBytes("abc", 3, 1), "Seed changes the hash");
+
+    const char *long_text = "a string long enough to go through the 16 byte loop more than once";
+    String a = S("a string long enough to go through the 16 byte loop more than once");
+    TEST_ASSERT(StrHash(a) == HashBytes(long_text, strlen(long_text), 0), "StrHash hashes the string contents");
+  }
+  TEST_END();
+}
+
+static void TestStringKeys(void) {
+  TEST_BEGIN("HashMapStringKeys");
+  {
+    StringIntMap map = {0};
+    TEST_ASSERT(HashMapGet(map, S("missing")) == NULL, "Empty map finds nothing");
+    TEST_ASSERT(!HashMapRemove(map, S("missing")), "Empty map removes nothing");
+
+    HashMapPut(map, S("one"), 1);
+    HashMapPut(map, S("two"), 2);
+    HashMapPut(map, S("three"), 3);
+    TEST_ASSERT(map.length == 3, "Three entries inserted");
+    TEST_ASSERT(*HashMapGet(map, S("two")) == 2, "Value is found by key");
+
+    char buffer[] = "one";
+    String same_contents = {3, buffer};
+    TEST_ASSERT(HashMapHas(map, same_contents), "String keys compare contents, not pointers");
+
+    HashMapPut(map, S("two"), 22);
+    TEST_ASSERT(map.length == 3 && *HashMapGet(map, S("two")) == 22, "Put overwrites an existing key");
+
+    *HashMapGet(map, S("three")) += 1;
+    TEST_ASSERT(*HashMapGet(map, S("three")) == 4, "Values can be updated through Get");
+
+    TEST_ASSERT(HashMapRemove(map, S("one")), "Remove finds the key");
+    TEST_ASSERT(!HashMapHas(map, S("one")) && map.length == 2, "Removed key is gone");
+
+    int32_t sum = 0;
+    HashMapForEach(map, it) {
+      sum += map.values[it];
+    }
+    TEST_ASSERT(sum == 26, "ForEach visits every entry");
+
+    (*HashMapEntry(map, S("counter")))++;
+    (*HashMapEntry(map, S("counter")))++;
+    TEST_ASSERT(*HashMapGet(map, S("counter")) == 2, "Entry inserts a zeroed value once and then reuses it");
+
+    HashMapClear(map);
+    TEST_ASSERT(map.length == 0 && !HashMapHas(map, S("two")), "Clear empties the map");
+    HashMapFree(map);
+    TEST_ASSERT(map.ctrl == NULL && map.capacity == 0, "Free resets the map");
+  }
+  TEST_END();
+}
+
+static void TestGrowthAndDeletion(void) {
+  TEST_BEGIN("HashMapGrowthAndDeletion");
+  {
+    U64Map map = {0};
+    const uint64_t count = 100000;
+    for (uint64_t i = 0; i < count; i++) {
+      HashMapPut(map, i * 7919, i);
+    }
+    TEST_ASSERT(map.length == count, "Every key was inserted");
+    TEST_ASSERT(map.length <= map.capacity - map.capacity / 8, "Load factor stays under 7/8");
+
+    bool all_found = true;
+    for (uint64_t i = 0; i < count; i++) {
+      uint64_t *value = HashMapGet(map, i * 7919);
+      if (value == NULL || *value != i) all_found = false;
+    }
+    TEST_ASSERT(all_found, "Every key maps to its value after growing");
+    TEST_ASSERT(!HashMapHas(map, (uint64_t)1), "Absent key is not found");
+
+    for (uint64_t i = 0; i < count; i += 2) {
+      HashMapRemove(map, i * 7919);
+    }
+    bool odds_left = true;
+    for (uint64_t i = 0; i < count; i++) {
+      if (HashMapHas(map, i * 7919) != (i % 2 == 1)) odds_left = false;
+    }
+    TEST_ASSERT(map.length == count / 2 && odds_left, "Removing half keeps the other half reachable");
+    HashMapFree(map);
+  }
+  {
+    // Insert and remove churn at a steady size must not grow the table forever
+    U64Map map = {0};
+    for (uint64_t i = 0; i < 1000; i++) {
+      HashMapPut(map, i, i);
+    }
+    size_t capacity = map.capacity;
+    for (uint64_t i = 1000; i < 200000; i++) {
+      HashMapRemove(map, i - 1000);
+      HashMapPut(map, i, i);
+    }
+    TEST_ASSERT(map.length == 1000 && map.capacity == capacity, "Churn reuses slots instead of growing");
+    TEST_ASSERT(*HashMapGet(map, (uint64_t)199999) == 199999, "Latest key is reachable after churn");
+    HashMapFree(map);
+  }
+  {
+    U64Map map = {0};
+    HashMapReserve(map, 1000);
+    size_t capacity = map.capacity;
+    for (uint64_t i = 0; i < 1000; i++) {
+      HashMapPut(map, i, i);
+    }
+    TEST_ASSERT(capacity >= 1000 && map.capacity == capacity, "Reserve avoids growing while filling");
+    HashMapFree(map);
+  }
+  {
+    // The value reads the map, it must be taken before the insert rehashes the table
+    U64Map map = {0};
+    HashMapPut(map, (uint64_t)0, 1);
+    for (uint64_t i = 1; i < 1000; i++) {
+      HashMapPut(map, i, *HashMapGet(map, i - 1) + 1);
+    }
+    TEST_ASSERT(*HashMapGet(map, (uint64_t)999) == 1000, "Put evaluates the value before growing");
+    HashMapFree(map);
+  }
+  TEST_END();
+}
+
+static void TestStructKeysAndArena(void) {
+  TEST_BEGIN("HashMapStructKeysAndArena");
+  {
+    Arena *arena = ArenaCreate(4096);
+    PointMap map = {.allocator = ArenaAllocator(arena)};
+    for (int32_t x = 0; x < 50; x++) {
+      for (int32_t y = 0; y < 50; y++) {
+        HashMapPut(map, ((Point){x, y}), F(arena, "%d,%d", x, y));
+      }
+    }
+
+    String *value = HashMapGet(map, ((Point){12, 34}));
+    TEST_ASSERT(value != NULL && StrEq(*value, S("12,34")), "Struct keys compare bytewise");
+    TEST_ASSERT(!HashMapHas(map, ((Point){50, 0})), "Missing struct key is not found");
+    TEST_ASSERT(map.length == 2500, "Arena backed map holds every entry");
+
+    HashMapFree(map);
+    TEST_ASSERT(map.allocator.context == arena, "Free keeps the allocator for reuse");
+    ArenaFree(arena);
+  }
+  TEST_END();
+}
+
+int main(void) {
+  StartTest();
+  {
+    TestHashing();
+    TestStringKeys();
+    TestGrowthAndDeletion();
+    TestStructKeysAndArena();
+  }
+  EndTest();
+}
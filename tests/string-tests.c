@@ -79,6 +79,35 @@ static void TestStringSplitting(void) {
     VecFree(parts);
     ArenaFree(arena);
   }
+  {
+    String text = S("a::b::::c::");
+    StrSplitIter it = StrSplitBegin(text, S("::"));
+    String expected[] = {S("a"), S("b"), S(""), S("c")};
+    size_t count = 0;
+    bool all_views = true;
+    for (String token; StrSplitNext(&it, &token); count++) {
+      if (count >= ARR_LEN(expected) || !StrEq(token, expected[count])) all_views = false;
+      if (token.data < text.data || token.data + token.length > text.data + text.length) all_views = false;
+    }
+    TEST_ASSERT(count == 4 && all_views, "Iterator yields views into the source, no trailing empty token");
+
+    StringVector views = StrSplitView(S("x\ny\n\nz"), S("\n"));
+    TEST_ASSERT(views.length == 4 && StrEq(views.data[3], S("z")) && views.data[2].length == 0, "SplitView keeps empty lines");
+    VecFree(views);
+
+    views = StrSplitView(S("abc"), S(""));
+    TEST_ASSERT(views.length == 3 && StrEq(views.data[1], S("b")), "Empty delimiter splits every byte");
+    VecFree(views);
+
+    views = StrSplitView(S(""), S(","));
+    TEST_ASSERT(views.length == 0 && views.data == NULL, "Empty string has no tokens");
+
+    Arena *arena = ArenaCreate(128);
+    StringVector parts = StrSplit(arena, S(",lead"), S(","));
+    TEST_ASSERT(parts.length == 2 && parts.data[0].length == 0 && parts.data[1].data[4] == '\0', "StrSplit still copies null terminated tokens");
+    VecFree(parts);
+    ArenaFree(arena);
+  }
   TEST_END();
 }
 
@@ -106,6 +135,70 @@ static void TestStringBuilderFunctionality(void) {
 
     ArenaFree(arena);
   }
+  {
+    Arena *arena = ArenaCreate(64 * 1024);
+    StringBuilder builder = SBCreate(arena);
+    char *start = builder.buffer.data;
+    for (size_t i = 0; i < 100; i++) {
+      SBAdd(&builder, S("0123456789"));
+    }
+    TEST_ASSERT(builder.buffer.data == start, "builder grows in place while it's the last arena allocation");
+    TEST_ASSERT(arena->offset == builder.capacity, "builder growth leaves no dead space in the arena");
+    ArenaFree(arena);
+  }
+  {
+    Arena *arena = ArenaCreate(4096);
+    StringBuilder created = SBCreate(arena);
+    TEST_ASSERT(created.arena_builder == arena, "deprecated arena_builder still points at the arena");
+
+    StringBuilder builder = {.arena_builder = arena};
+    SBAdd(&builder, S("Hello"));
+    TEST_ASSERT(StrEq(builder.buffer, S("Hello")), "builder with only arena_builder set appends");
+    TEST_ASSERT(arena->offset == created.capacity + builder.capacity, "builder with only arena_builder set allocates from that arena");
+    ArenaFree(arena);
+  }
+  {
+    StringBuilder builder = SBCreateWith(HeapAllocator());
+    for (size_t i = 0; i < 100; i++) {
+      SBAdd(&builder, S("0123456789"));
+    }
+    TEST_ASSERT(builder.buffer.length == 1000, "heap builder length incorrect after growing");
+    TEST_ASSERT(builder.buffer.data[999] == '9' && builder.buffer.data[1000] == '\0', "heap builder data incorrect after growing");
+    SBFree(&builder);
+    TEST_ASSERT(builder.buffer.data == NULL, "SBFree resets the builder");
+  }
+  {
+    Arena *arena = ArenaCreate(4096);
+    StringBuilder builder = SBCreateChunkedWith(ArenaAllocator(arena), 16);
+    SBAdd(&builder, S("0123456789"));
+    __SBChunk *first = builder.head;
+    for (size_t i = 0; i < 9; i++) {
+      SBAdd(&builder, S("0123456789"));
+    }
+    SBAddF(&builder, "%d", 42);
+    SBAdd(&builder, S("a string longer than one whole chunk"));
+    TEST_ASSERT(builder.head == first && first->length == 16, "chunks are filled and never moved");
+    TEST_ASSERT(builder.buffer.data == NULL, "chunked builder leaves the flat buffer alone");
+    TEST_ASSERT(SBLength(&builder) == 100 + 2 + 36, "chunked length counts every chunk");
+
+    String joined = SBToString(arena, &builder);
+    TEST_ASSERT(joined.length == SBLength(&builder) && joined.data[joined.length] == '\0', "joined string is null terminated");
+    TEST_ASSERT(StrEq(StrSlice(arena, joined, 90, 104), S("012345678942a ")), "joined string keeps append order");
+    StringBuilder empty = SBCreateChunked(arena);
+    TEST_ASSERT(StrEq(SBToString(arena, &empty), S("")), "empty chunked builder joins to an empty string");
+    ArenaFree(arena);
+  }
+  {
+    StringBuilder builder = SBCreateChunkedWith(HeapAllocator(), 0);
+    TEST_ASSERT(builder.chunk_size == SB_CHUNK_SIZE, "zero chunk size picks the default");
+    TEST_ASSERT(SBLength(&builder) == 0 && builder.head == NULL, "chunks are only allocated on first append");
+    for (size_t i = 0; i < 10000; i++) {
+      SBAdd(&builder, S("0123456789"));
+    }
+    TEST_ASSERT(SBLength(&builder) == 100000 && builder.head != builder.tail, "heap chunked builder spans several chunks");
+    SBFree(&builder);
+    TEST_ASSERT(builder.head == NULL && builder.chunk_size == 0, "SBFree releases every chunk");
+  }
   TEST_END();
 }
 
@@ -168,6 +261,62 @@ static void TestStringBuilderFormat(void) {
     TEST_ASSERT(StrEq(builder.buffer, S("0 0 0 0")), "zero values incorrect");
     ArenaFree(arena);
   }
+  {
+    Arena *arena = ArenaCreate(256);
+    StringBuilder builder = SBCreate(arena);
+    SBAddF(&builder, "%x %X %lx %c %p", 255u, 0xBEEFu, (uint64_t)UINT64_MAX, 'z', (void *)0x1f00);
+    TEST_ASSERT(StrEq(builder.buffer, S("ff BEEF ffffffffffffffff z 0x1f00")), "%x %X %lx %c %p incorrect");
+    ArenaFree(arena);
+  }
+  {
+    Arena *arena = ArenaCreate(256);
+    StringBuilder builder = SBCreate(arena);
+    SBAddF(&builder, "[%5d|%-5d|%05d|%08x|%-4s|%3S|%06p]", 42, 42, -42, 0xABCu, "ab", S("c"), (void *)0xF);
+    TEST_ASSERT(StrEq(builder.buffer, S("[   42|42   |-0042|00000abc|ab  |  c|0x000f]")), "width and padding incorrect");
+    ArenaFree(arena);
+  }
+  {
+    Arena *arena = ArenaCreate(256);
+    StringBuilder builder = SBCreate(arena);
+    SBAddF(&builder, "%g %g %g %g %g %g", 0.1, 1.0 / 3, 100.0, 1e21, 1e-7, -0.0);
+    TEST_ASSERT(StrEq(builder.buffer, S("0.1 0.3333333333333333 100 1e+21 1e-07 -0")), "%g shortest incorrect");
+    ArenaFree(arena);
+  }
+  {
+    Arena *arena = ArenaCreate(256);
+    StringBuilder builder = SBCreate(arena);
+    SBAddF(&builder, "%f %.2f %.0f %.3f %.3g %.1g %08.2f %-6f|", 123.456, 0.125, 9.5, 1e-5, 123456.0, 0.96, -3.14159, 2.5);
+    TEST_ASSERT(StrEq(builder.buffer, S("123.456 0.13 10 0.000 1.23e+05 1 -0003.14 2.5   |")), "%f and precision incorrect");
+    ArenaFree(arena);
+  }
+  {
+    Arena *arena = ArenaCreate(256);
+    StringBuilder builder = SBCreate(arena);
+    SBAddF(&builder, "%g %f %05g", 1.0 / 0.0, -1.0 / 0.0, 0.0 / 0.0);
+    TEST_ASSERT(StrEq(builder.buffer, S("inf -inf   nan")), "inf and nan incorrect");
+    ArenaFree(arena);
+  }
+  {
+    // Every formatted double must parse back to the same value
+    Arena *arena = ArenaCreate(4096);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    bool round_trips = true;
+    for (int32_t i = 0; i < 100000; i++) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      double value;
+      memcpy(&value, &state, sizeof(value));
+      if (value != value || value - value != 0) continue;
+
+      StringBuilder builder = SBCreate(arena);
+      SBAddF(&builder, "%g", value);
+      if (strtod(builder.buffer.data, NULL) != value) round_trips = false;
+      ArenaReset(arena);
+    }
+    TEST_ASSERT(round_trips, "%g round-trips random doubles");
+    ArenaFree(arena);
+  }
   TEST_END();
 }
 
@@ -262,6 +411,271 @@ static void TestStringEdgeCases(void) {
   TEST_END();
 }
 
+static ssize_t NaiveFind(String haystack, String needle, bool last) {
+  ssize_t found = -1;
+  for (size_t i = 0; i + needle.length <= haystack.length; i++) {
+    if (memcmp(haystack.data + i, needle.data, needle.length) == 0) {
+      found = (ssize_t)i;
+      if (!last) break;
+    }
+  }
+  return found;
+}
+
+static void TestStringFind(void) {
+  TEST_BEGIN("String Find");
+  {
+    String text = S("the quick brown fox jumps over the lazy dog, the end");
+    TEST_ASSERT(StrFind(text, S("the")) == 0, "Find returns the first match");
+    TEST_ASSERT(StrFindLast(text, S("the")) == 45, "FindLast returns the last match");
+    TEST_ASSERT(StrFind(text, S("lazy dog")) == 35, "Find past the first SIMD block");
+    TEST_ASSERT(StrFind(text, S("cat")) == -1, "Missing needle returns -1");
+    TEST_ASSERT(StrFind(S("ab"), S("abc")) == -1, "Needle longer than haystack returns -1");
+    TEST_ASSERT(StrFind(text, S("")) == 0 && StrFindLast(text, S("")) == (ssize_t)text.length, "Empty needle matches at the ends");
+    TEST_ASSERT(StrFindChar(text, 'q') == 4 && StrFindChar(text, 'z') == 37, "FindChar returns the first byte");
+    TEST_ASSERT(StrFindChar(text, '#') == -1 && StrFindChar(S(""), 'a') == -1, "FindChar misses return -1");
+  }
+  {
+    // Brute force against a naive search over lengths that straddle every block size
+    Arena *arena = ArenaCreate(4096);
+    RandomSetSeed(99);
+    bool all_match = true;
+    for (int32_t round = 0; round < 2000; round++) {
+      size_t haystack_length = (size_t)RandomInteger(0, 100);
+      size_t needle_length = (size_t)RandomInteger(1, 6);
+      String haystack = {haystack_length, ArenaAlloc(arena, haystack_length + 1)};
+      char needle_data[6];
+      String needle = {needle_length, needle_data};
+      for (size_t i = 0; i < haystack_length; i++) {
+        haystack.data[i] = (char)('a' + RandomInteger(0, 2));
+      }
+      for (size_t i = 0; i < needle_length; i++) {
+        needle_data[i] = (char)('a' + RandomInteger(0, 2));
+      }
+
+      if (StrFind(haystack, needle) != NaiveFind(haystack, needle, false)) all_match = false;
+      if (StrFindLast(haystack, needle) != NaiveFind(haystack, needle, true)) all_match = false;
+      if (StrIncludes(haystack, needle) != (NaiveFind(haystack, needle, false) >= 0)) all_match = false;
+    }
+    TEST_ASSERT(all_match, "Find, FindLast and Includes agree with a naive search");
+    ArenaFree(arena);
+  }
+  TEST_END();
+}
+
+static void TestStringInterning(void) {
+  TEST_BEGIN("String Interning");
+  {
+    InternTable *table = InternTableCreate();
+    TEST_ASSERT(StrInternFind(table, S("ini")) == 0, "Nothing is interned yet");
+
+    InternId ini = StrIntern(table, S("ini"));
+    InternId log = StrIntern(table, S("log"));
+    TEST_ASSERT(ini != 0 && log != 0 && ini != log, "Distinct strings get distinct ids");
+
+    char buffer[] = "ini";
+    TEST_ASSERT(StrIntern(table, (String){3, buffer}) == ini, "Equal contents get the same id");
+    buffer[0] = 'x';
+    TEST_ASSERT(StrEq(InternGet(table, ini), S("ini")), "Interned bytes are owned by the table");
+    TEST_ASSERT(InternGet(table, ini).data[3] == '\0', "Interned strings are null terminated");
+    TEST_ASSERT(StrInternFind(table, S("log")) == log, "Find returns the existing id");
+    TEST_ASSERT(StrInternFind(table, S("xini")) == 0, "Find does not intern");
+
+    Arena *arena = ArenaCreate(1024);
+    for (int32_t i = 0; i < 1000; i++) {
+      StrIntern(table, F(arena, "tag-%d", i % 100));
+    }
+    TEST_ASSERT(table->strings.length == 102, "Duplicates are stored once");
+    TEST_ASSERT(StrIntern(table, S("tag-42")) == StrIntern(table, F(arena, "tag-%d", 42)), "Ids stay stable across growth");
+
+    ArenaFree(arena);
+    InternTableFree(table);
+  }
+  TEST_END();
+}
+
+static void TestStringCaseAndTrim(void) {
+  TEST_BEGIN("StringCaseAndTrim");
+  {
+    // Every byte value at every offset of a buffer long enough for the SIMD, SWAR and byte loops
+    char upper[300], lower[300];
+    bool upper_matches = true, lower_matches = true;
+    for (size_t length = 0; length < 300; length += 37) {
+      for (size_t i = 0; i < length; i++) {
+        upper[i] = lower[i] = (char)(i * 7 + length);
+      }
+      StrToUpper((String){length, upper});
+      StrToLower((String){length, lower});
+      for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)(i * 7 + length);
+        unsigned char expected_upper = (c >= 'a' && c <= 'z') ? c - 32 : c;
+        unsigned char expected_lower = (c >= 'A' && c <= 'Z') ? c + 32 : c;
+        if ((unsigned char)upper[i] != expected_upper) upper_matches = false;
+        if ((unsigned char)lower[i] != expected_lower) lower_matches = false;
+      }
+    }
+    TEST_ASSERT(upper_matches, "StrToUpper only changes ASCII lower case letters");
+    TEST_ASSERT(lower_matches, "StrToLower only changes ASCII upper case letters");
+  }
+  {
+    String mixed = S("The Quick Brown Fox Jumps Over The Lazy Dog, 0123456789 [@`{]");
+    String folded = S("tHE qUICK bROWN fOX jUMPS oVER tHE lAZY dOG, 0123456789 [@`{]");
+    TEST_ASSERT(StrEqIgnoreCase(mixed, folded), "Case insensitive compare ignores letter case");
+    TEST_ASSERT(!StrEqIgnoreCase(S("[@`{]"), S("{`@[]")), "Bytes next to the letter ranges are not folded");
+    TEST_ASSERT(!StrEqIgnoreCase(S("abc"), S("abcd")), "Different lengths are not equal");
+    TEST_ASSERT(!StrEqIgnoreCase(mixed, S("The Quick Brown Fox Jumps Over The Lazy Cat, 0123456789 [@`{]")),
+                "Different letters are not equal");
+    TEST_ASSERT(StrEqIgnoreCase(S(""), S("")), "Empty strings are equal");
+
+    TEST_ASSERT(StrHashIgnoreCase(mixed) == StrHashIgnoreCase(folded), "Case insensitive hash ignores letter case");
+    TEST_ASSERT(StrHashIgnoreCase(S("Hello")) == StrHash(S("hello")), "Short strings hash like their lower case form");
+    TEST_ASSERT(StrHashIgnoreCase(S("hello")) != StrHashIgnoreCase(S("help!")), "Different strings hash differently");
+
+    char long_a[600], long_b[600];
+    for (size_t i = 0; i < sizeof(long_a); i++) {
+      long_a[i] = (char)('a' + i % 26);
+      long_b[i] = (char)('A' + i % 26);
+    }
+    TEST_ASSERT(StrHashIgnoreCase((String){sizeof(long_a), long_a}) == StrHashIgnoreCase((String){sizeof(long_b), long_b}),
+                "Hash spanning several chunks ignores letter case");
+  }
+  {
+    String padded = S(" \t\r\n hello world \n\t");
+    String view = StrTrimView(padded);
+    TEST_ASSERT(StrEq(view, S("hello world")), "Trim view drops surrounding whitespace");
+    TEST_ASSERT(view.data == padded.data + 5, "Trim view points into the original string");
+    TEST_ASSERT(StrTrimView(S(" \t\n ")).length == 0, "All whitespace trims to empty");
+    TEST_ASSERT(StrTrimView(S("")).length == 0, "Empty string trims to empty");
+    TEST_ASSERT(StrEq(StrTrimView(S("x")), S("x")), "Nothing to trim keeps the string");
+  }
+  TEST_END();
+}
+
+static void TestIntegerToString(void) {
+  TEST_BEGIN("IntegerToString");
+  {
+    Arena *arena = ArenaCreate(4096);
+    TEST_ASSERT(StrEq(StrFromU64(arena, 0), S("0")), "StrFromU64 zero incorrect");
+    TEST_ASSERT(StrEq(StrFromU64(arena, UINT64_MAX), S("18446744073709551615")), "StrFromU64 max incorrect");
+    TEST_ASSERT(StrEq(StrFromI64(arena, INT64_MIN), S("-9223372036854775808")), "StrFromI64 min incorrect");
+    TEST_ASSERT(StrEq(StrFromI64(arena, -7), S("-7")), "StrFromI64 negative incorrect");
+    String number = StrFromU64(arena, 12345);
+    TEST_ASSERT(number.length == 5 && number.data[5] == '\0', "StrFromU64 is null terminated");
+
+    // Both sides of every power of ten, where the digit count changes
+    bool all_match = true;
+    for (uint64_t power = 1, i = 0; i < 20; i++, power *= 10) {
+      uint64_t values[] = {power - 1, power, power + 1};
+      for (size_t j = 0; j < 3; j++) {
+        char expected[32];
+        snprintf(expected, sizeof(expected), "%" PRIu64, values[j]);
+        if (!StrEq(StrFromU64(arena, values[j]), StrNew(arena, expected))) all_match = false;
+        snprintf(expected, sizeof(expected), "%" PRId64, -(int64_t)(values[j] / 2));
+        if (!StrEq(StrFromI64(arena, -(int64_t)(values[j] / 2)), StrNew(arena, expected))) all_match = false;
+      }
+    }
+    TEST_ASSERT(all_match, "integers around every power of ten match snprintf");
+    ArenaFree(arena);
+  }
+  {
+    Arena *arena = ArenaCreate(256);
+    StringBuilder builder = SBCreate(arena);
+    SBAddU64(&builder, 42);
+    SBAddS(&builder, ",");
+    SBAddI64(&builder, INT64_MIN);
+    for (int32_t i = 0; i < 100; i++) {
+      SBAddU64(&builder, UINT64_MAX);
+    }
+    TEST_ASSERT(builder.buffer.length == 2 + 1 + 20 + 100 * 20, "SBAddU64/SBAddI64 length incorrect");
+    TEST_ASSERT(StrEq(StrSlice(arena, builder.buffer, 0, 23), S("42,-9223372036854775808")), "SBAddU64/SBAddI64 content incorrect");
+    TEST_ASSERT(builder.buffer.data[builder.buffer.length] == '\0', "builder stays null terminated");
+
+    StringBuilder chunked = SBCreateChunkedWith(ArenaAllocator(arena), 8);
+    SBAddS(&chunked, "abcde");
+    SBAddI64(&chunked, -1234567);
+    TEST_ASSERT(StrEq(SBToString(arena, &chunked), S("abcde-1234567")), "chunked builder number straddles chunks");
+    ArenaFree(arena);
+  }
+  TEST_END();
+}
+
+static void TestNumberParsing(void) {
+  TEST_BEGIN("NumberParsing");
+  {
+    TEST_ASSERT(StrParseI64(S("12345678901234")).data == 12345678901234, "StrParseI64 long run of digits");
+    TEST_ASSERT(StrParseI64(S("-42")).data == -42 && StrParseI64(S("+42")).data == 42, "StrParseI64 signs");
+    ParseI64Result min = StrParseI64(S("-9223372036854775808"));
+    TEST_ASSERT(min.error == SUCCESS && min.data == INT64_MIN, "StrParseI64 min");
+    ParseI64Result too_big = StrParseI64(S("9223372036854775808"));
+    TEST_ASSERT(too_big.error == PARSE_OVERFLOW && too_big.data == INT64_MAX, "StrParseI64 overflow clamps");
+    ParseI64Result trailing = StrParseI64(S("123abc"));
+    TEST_ASSERT(trailing.error == PARSE_TRAILING_CHARS && trailing.data == 123, "StrParseI64 trailing characters keep the number");
+    TEST_ASSERT(StrParseI64(S("")).error == PARSE_INVALID, "StrParseI64 empty string");
+    TEST_ASSERT(StrParseI64(S("-")).error == PARSE_INVALID, "StrParseI64 lone sign");
+    TEST_ASSERT(StrParseI64(S(" 1")).error == PARSE_INVALID, "StrParseI64 does not skip whitespace");
+
+    ParseU64Result max = StrParseU64(S("18446744073709551615"));
+    TEST_ASSERT(max.error == SUCCESS && max.data == UINT64_MAX, "StrParseU64 max");
+    ParseU64Result overflow = StrParseU64(S("18446744073709551616"));
+    TEST_ASSERT(overflow.error == PARSE_OVERFLOW && overflow.data == UINT64_MAX, "StrParseU64 overflow");
+    TEST_ASSERT(StrParseU64(S("000000000000000000000000000001")).data == 1, "StrParseU64 leading zeros");
+    TEST_ASSERT(StrParseU64(S("-1")).error == PARSE_INVALID, "StrParseU64 rejects negatives");
+
+    // A view into a longer buffer parses only its own bytes
+    String digits = S("1234567890");
+    TEST_ASSERT(StrParseU64((String){4, digits.data}).data == 1234, "StrParseU64 stops at the view's end");
+
+    bool all_match = true;
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (int32_t i = 0; i < 100000; i++) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      int64_t expected = (int64_t)(state >> (i % 64));
+      if (i & 1) expected = -expected;
+      char text[32];
+      snprintf(text, sizeof(text), "%" PRId64, expected);
+      ParseI64Result parsed = StrParseI64((String){strlen(text), text});
+      if (parsed.error != SUCCESS || parsed.data != expected) all_match = false;
+    }
+    TEST_ASSERT(all_match, "StrParseI64 matches random integers of every length");
+  }
+  {
+    TEST_ASSERT(StrParseF64(S("3.25")).data == 3.25, "StrParseF64 simple");
+    TEST_ASSERT(StrParseF64(S("-0.001")).data == -0.001, "StrParseF64 negative fraction");
+    TEST_ASSERT(StrParseF64(S("1e10")).data == 1e10 && StrParseF64(S("2.5E-3")).data == 2.5e-3, "StrParseF64 exponent");
+    TEST_ASSERT(StrParseF64(S(".5")).data == 0.5 && StrParseF64(S("5.")).data == 5.0, "StrParseF64 bare point");
+    TEST_ASSERT(StrParseF64(S("1.7976931348623157e308")).data == 1.7976931348623157e308, "StrParseF64 max double");
+    TEST_ASSERT(StrParseF64(S("4.9406564584124654e-324")).data == 4.9406564584124654e-324, "StrParseF64 min subnormal");
+    TEST_ASSERT(StrParseF64(S("0.1000000000000000055511151231257827")).data == 0.1, "StrParseF64 many digits");
+    TEST_ASSERT(StrParseF64(S("-inf")).data == -HUGE_VAL && StrParseF64(S("Infinity")).data == HUGE_VAL, "StrParseF64 infinity");
+    float64_t nan_value = StrParseF64(S("nan")).data;
+    TEST_ASSERT(nan_value != nan_value, "StrParseF64 nan");
+
+    TEST_ASSERT(StrParseF64(S("1e999")).error == PARSE_OVERFLOW, "StrParseF64 overflow");
+    ParseF64Result trailing = StrParseF64(S("2.5e"));
+    TEST_ASSERT(trailing.error == PARSE_TRAILING_CHARS && trailing.data == 2.5, "StrParseF64 bare exponent is trailing");
+    TEST_ASSERT(StrParseF64(S(".")).error == PARSE_INVALID && StrParseF64(S("e5")).error == PARSE_INVALID, "StrParseF64 invalid");
+
+    bool all_match = true;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (int32_t i = 0; i < 100000; i++) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      float64_t expected;
+      memcpy(&expected, &state, sizeof(expected));
+      if (expected != expected) continue;
+      char text[64];
+      snprintf(text, sizeof(text), (i & 1) ? "%.17g" : "%.6g", expected);
+      ParseF64Result parsed = StrParseF64((String){strlen(text), text});
+      if (parsed.data != strtod(text, NULL)) all_match = false;
+    }
+    TEST_ASSERT(all_match, "StrParseF64 matches strtod on random doubles");
+  }
+  TEST_END();
+}
+
 int main(void) {
   StartTest();
   {
@@ -274,6 +688,11 @@ int main(void) {
     TestStringSlicing();
     TestStringIncludes();
     TestStringEdgeCases();
+    TestStringFind();
+    TestStringInterning();
+    TestStringCaseAndTrim();
+    TestIntegerToString();
+    TestNumberParsing();
   }
   EndTest();
 }
@@ -59,6 +59,21 @@ static void TestPushPop(void) {
 
     VecFree(vec);
   }
+  {
+    VEC_TYPE(IntVector, int32_t);
+    IntVector numbers = {0};
+    VecPush(numbers, 42);
+    for (int32_t i = 0; i < 1000; i++) {
+      VecPush(numbers, i * 2 + 1);
+    }
+    TEST_ASSERT(numbers.length == 1001 && numbers.data[0] == 42, "push accepts rvalues");
+    TEST_ASSERT(numbers.data[1000] == 1999, "pushed rvalues survive growth");
+
+    if (numbers.length > 0) VecPush(numbers, 7);
+    else VecPush(numbers, 8);
+    TEST_ASSERT(numbers.data[numbers.length - 1] == 7, "push is a single statement");
+    VecFree(numbers);
+  }
   TEST_END();
 }
 
@@ -187,6 +202,443 @@ static void TestSort(void) {
     TEST_ASSERT(is_sorted, "vector is correctly sorted");
     VecFree(numbers);
   }
+  {
+    VEC_TYPE(IntVector, int);
+    IntVector numbers = {0};
+    const size_t count = 100000;
+    VecReserve(numbers, count);
+    numbers.length = count;
+
+    const char *patterns[] = {"random input is sorted", "sorted input is sorted", "reversed input is sorted", "duplicate heavy input is sorted", "organ pipe input is sorted"};
+    for (size_t pattern = 0; pattern < sizeof(patterns) / sizeof(patterns[0]); pattern++) {
+      RandomSetSeed(42);
+      for (size_t i = 0; i < count; i++) {
+        switch (pattern) {
+          case 0: numbers.data[i] = (int)RandomInteger(-1000000, 1000000); break;
+          case 1: numbers.data[i] = (int)i; break;
+          case 2: numbers.data[i] = (int)(count - i); break;
+          case 3: numbers.data[i] = (int)RandomInteger(0, 3); break;
+          default: numbers.data[i] = (int)(i < count / 2 ? i : count - i); break;
+        }
+      }
+
+      int64_t sum_before = 0, sum_after = 0;
+      for (size_t i = 0; i < count; i++) {
+        sum_before += numbers.data[i];
+      }
+      VecSort(numbers, compare_int);
+
+      bool is_sorted = true;
+      for (size_t i = 0; i < count; i++) {
+        sum_after += numbers.data[i];
+        if (i > 0 && numbers.data[i] < numbers.data[i - 1]) is_sorted = false;
+      }
+      TEST_ASSERT(is_sorted && sum_before == sum_after, patterns[pattern]);
+    }
+    VecFree(numbers);
+  }
+  {
+    typedef struct {
+      int key;
+      char payload[100];
+    } Wide;
+    VEC_TYPE(WideVector, Wide);
+    WideVector wides = {0};
+    for (int i = 0; i < 500; i++) {
+      Wide wide = {.key = (i * 7919) % 500};
+      wide.payload[99] = (char)wide.key;
+      VecPush(wides, wide);
+    }
+
+    VecSort(wides, compare_int);
+    bool intact = true;
+    for (int i = 0; i < 500; i++) {
+      if (wides.data[i].key != i || wides.data[i].payload[99] != (char)i) intact = false;
+    }
+    TEST_ASSERT(intact, "elements wider than the swap buffer are sorted whole");
+    VecFree(wides);
+  }
+  TEST_END();
+}
+
+typedef struct {
+  int32_t age;
+  String name;
+} Person;
+VEC_SORT_IMPL(SortByAge, Person, a->age < b->age);
+VEC_SORT_IMPL(SortIntsDescending, int32_t, *a > *b);
+
+static void TestTypedSort(void) {
+  TEST_BEGIN("VectorTypedSort");
+  {
+    VEC_TYPE(PersonVector, Person);
+    PersonVector people = {0};
+    RandomSetSeed(7);
+    for (int32_t i = 0; i < 5000; i++) {
+      Person person = {.age = RandomInteger(0, 100), .name = S("someone")};
+      VecPush(people, person);
+    }
+
+    VecSortTyped(people, SortByAge);
+    bool is_sorted = true;
+    for (size_t i = 1; i < people.length; i++) {
+      if (people.data[i].age < people.data[i - 1].age) is_sorted = false;
+    }
+    TEST_ASSERT(is_sorted, "struct vector is sorted by the inlined key");
+    VecFree(people);
+  }
+  {
+    VEC_TYPE(IntVector, int32_t);
+    IntVector numbers = {0};
+    for (int32_t i = 0; i < 1000; i++) {
+      VecPush(numbers, i);
+    }
+
+    VecSortTyped(numbers, SortIntsDescending);
+    TEST_ASSERT(numbers.data[0] == 999 && numbers.data[999] == 0, "custom less expression reverses the order");
+    VecFree(numbers);
+  }
+  {
+    VEC_TYPE(U32Vector, uint32_t);
+    VEC_TYPE(U64Vector, uint64_t);
+    U32Vector small = {0};
+    U32Vector u32s = {0};
+    U64Vector u64s = {0};
+    RandomSetSeed(11);
+    for (uint32_t i = 0; i < 100000; i++) {
+      uint32_t value = ((uint32_t)RandomInteger(0, 65535) << 16) ^ (uint32_t)RandomInteger(0, 65535);
+      uint64_t wide = ((uint64_t)value << 32) | (i % 3);
+      VecPush(u32s, value);
+      VecPush(u64s, wide);
+      if (i < 100) VecPush(small, value);
+    }
+
+    VecRadixSortU32(u32s);
+    VecRadixSortU64(u64s);
+    VecRadixSortU32(small);
+    bool u32_sorted = true, u64_sorted = true, small_sorted = true;
+    for (size_t i = 1; i < u32s.length; i++) {
+      if (u32s.data[i] < u32s.data[i - 1]) u32_sorted = false;
+      if (u64s.data[i] < u64s.data[i - 1]) u64_sorted = false;
+      if (i < small.length && small.data[i] < small.data[i - 1]) small_sorted = false;
+    }
+    TEST_ASSERT(u32_sorted, "u32 radix sort orders every key");
+    TEST_ASSERT(u64_sorted, "u64 radix sort orders every key");
+    TEST_ASSERT(small_sorted, "short vectors fall back to the comparison sort");
+    VecFree(small);
+    VecFree(u32s);
+    VecFree(u64s);
+  }
+  {
+    VEC_TYPE(FloatVector, float32_t);
+    FloatVector floats = {0};
+    RandomSetSeed(13);
+    for (int32_t i = 0; i < 2000; i++) {
+      float32_t value = RandomFloat(-1000.0f, 1000.0f);
+      VecPush(floats, value);
+    }
+    float32_t specials[] = {0.0f, -0.0f, -1e30f, 1e30f, -0.5f};
+    for (size_t i = 0; i < ARR_LEN(specials); i++) {
+      VecPush(floats, specials[i]);
+    }
+
+    VecRadixSortF32(floats);
+    bool is_sorted = true;
+    for (size_t i = 1; i < floats.length; i++) {
+      if (floats.data[i] < floats.data[i - 1]) is_sorted = false;
+    }
+    TEST_ASSERT(is_sorted, "f32 radix sort handles negatives");
+    TEST_ASSERT(floats.data[0] == -1e30f && floats.data[floats.length - 1] == 1e30f, "f32 radix sort keeps extremes at the ends");
+    VecFree(floats);
+  }
+  TEST_END();
+}
+
+typedef struct {
+  int32_t key;
+  int32_t order;
+} Keyed;
+
+static int32_t compare_keyed(const void *a, const void *b) {
+  return ((const Keyed *)a)->key - ((const Keyed *)b)->key;
+}
+
+static void TestParallelSort(void) {
+  TEST_BEGIN("VectorParallelSort");
+  {
+    VEC_TYPE(IntVector, int);
+    IntVector numbers = {0};
+    IntVector expected = {0};
+    RandomSetSeed(21);
+    for (int32_t i = 0; i < 200003; i++) {
+      int value = (int)RandomInteger(-100000, 100000);
+      VecPush(numbers, value);
+      VecPush(expected, value);
+    }
+
+    VecSort(expected, compare_int);
+    VecSortParallel(numbers, compare_int, 5);
+    TEST_ASSERT(memcmp(numbers.data, expected.data, numbers.length * sizeof(int)) == 0, "parallel sort matches VecSort");
+
+    VecSortParallel(numbers, compare_int, 0);
+    TEST_ASSERT(memcmp(numbers.data, expected.data, numbers.length * sizeof(int)) == 0, "parallel sort of sorted input with one worker per core");
+    VecFree(numbers);
+    VecFree(expected);
+  }
+  {
+    VEC_TYPE(KeyedVector, Keyed);
+    KeyedVector items = {0};
+    RandomSetSeed(22);
+    for (int32_t i = 0; i < 100000; i++) {
+      Keyed item = {.key = RandomInteger(0, 50), .order = i};
+      VecPush(items, item);
+    }
+
+    VecSortParallelStable(items, compare_keyed, 3);
+    bool stable = true;
+    for (size_t i = 1; i < items.length; i++) {
+      Keyed prev = items.data[i - 1], current = items.data[i];
+      if (prev.key > current.key || (prev.key == current.key && prev.order > current.order)) stable = false;
+    }
+    TEST_ASSERT(stable, "stable parallel sort keeps equal keys in insertion order");
+
+    Keyed small[] = {{2, 0}, {1, 1}, {2, 2}, {1, 3}};
+    __base_vec_sort_parallel(small, ARR_LEN(small), sizeof(Keyed), compare_keyed, 8, true);
+    TEST_ASSERT(small[0].order == 1 && small[1].order == 3 && small[2].order == 0 && small[3].order == 2, "short vectors use the single threaded stable sort");
+    VecFree(items);
+  }
+  TEST_END();
+}
+
+static void TestBulkOperations(void) {
+  TEST_BEGIN("VectorBulkOperations");
+  {
+    VEC_TYPE(IntVector, int32_t);
+    IntVector numbers = {0};
+    int32_t values[300];
+    for (int32_t i = 0; i < 300; i++) {
+      values[i] = i;
+    }
+
+    VecPushMany(numbers, values, 3);
+    TEST_ASSERT(numbers.length == 3 && numbers.capacity == VEC_MIN_CAPACITY, "push many starts at the minimum capacity");
+    VecPushMany(numbers, values + 3, 297);
+    TEST_ASSERT(numbers.length == 300 && numbers.capacity == 512, "push many grows once to fit the whole range");
+    TEST_ASSERT(numbers.data[0] == 0 && numbers.data[299] == 299, "push many copies the values in order");
+
+    IntVector other = {0};
+    VecPush(other, values[7]);
+    VecExtend(numbers, other);
+    TEST_ASSERT(numbers.length == 301 && numbers.data[300] == 7, "extend appends another vector");
+
+    VecResize(numbers, 1000);
+    TEST_ASSERT(numbers.length == 1000 && numbers.data[300] == 7 && numbers.data[999] == 0, "resize keeps old elements and zeroes new ones");
+    VecResize(numbers, 10);
+    TEST_ASSERT(numbers.length == 10 && numbers.capacity == 1024, "resize down keeps the capacity");
+
+    VecShrinkToFit(numbers);
+    TEST_ASSERT(numbers.capacity == 10 && numbers.data[9] == 9, "shrink to fit trims the capacity");
+    VecPush(numbers, values[0]);
+    TEST_ASSERT(numbers.capacity == 20, "growth after shrinking follows the policy");
+
+    VecResize(numbers, 0);
+    VecShrinkToFit(numbers);
+    TEST_ASSERT(numbers.data == NULL && numbers.capacity == 0, "shrinking an empty vector frees it");
+    VecFree(other);
+  }
+  {
+    VEC_TYPE(IntVector, int32_t);
+    IntVector numbers = {0};
+    int32_t value = 1;
+    VecUnshift(numbers, value);
+    TEST_ASSERT(numbers.capacity == VEC_MIN_CAPACITY, "unshift uses the same growth policy as push");
+    VecFree(numbers);
+    VecInsert(numbers, value, 0);
+    TEST_ASSERT(numbers.capacity == VEC_MIN_CAPACITY, "insert uses the same growth policy as push");
+    VecFree(numbers);
+  }
+  {
+    // A full vector extended with itself must copy from the grown buffer, not the freed one
+    VEC_TYPE(IntVector, int32_t);
+    IntVector numbers = {0};
+    for (int32_t i = 0; i < VEC_MIN_CAPACITY; i++) {
+      VecPush(numbers, i);
+    }
+    VecExtend(numbers, numbers);
+    TEST_ASSERT(numbers.length == 2 * VEC_MIN_CAPACITY, "self extend doubles the length");
+    TEST_ASSERT(numbers.data[VEC_MIN_CAPACITY] == 0 && numbers.data[2 * VEC_MIN_CAPACITY - 1] == VEC_MIN_CAPACITY - 1, "self extend copies the original elements");
+
+    VecPushMany(numbers, numbers.data + 10, numbers.capacity - numbers.length + 5);
+    TEST_ASSERT(numbers.data[2 * VEC_MIN_CAPACITY] == 10, "push many from an inner range survives growth");
+    VecFree(numbers);
+  }
+  {
+    VEC_TYPE(IntVector, int32_t);
+    Arena *arena = ArenaCreate(64 * 1024);
+    Allocator allocator = ArenaAllocator(arena);
+    IntVector numbers = {0};
+    int32_t values[] = {1, 2, 3};
+    VecPushManyWith(numbers, values, 3, allocator);
+    VecResizeWith(numbers, 200, allocator);
+    TEST_ASSERT(numbers.length == 200 && numbers.data[2] == 3 && numbers.data[199] == 0, "resize with an arena allocator");
+    VecResizeWith(numbers, 5, allocator);
+    VecShrinkToFitWith(numbers, allocator);
+    TEST_ASSERT(numbers.capacity == 5 && numbers.data[0] == 1, "shrink to fit with an arena allocator");
+    VecResizeWith(numbers, 0, allocator);
+    VecShrinkToFitWith(numbers, allocator);
+    TEST_ASSERT(numbers.data == NULL, "shrinking an empty arena vector releases it");
+    ArenaFree(arena);
+  }
+  TEST_END();
+}
+
+static void TestSmallVec(void) {
+  TEST_BEGIN("SmallVec");
+  {
+    SMALLVEC_TYPE(SmallInts, int32_t, 4);
+    SmallInts numbers = {0};
+    for (int32_t i = 0; i < 4; i++) {
+      SmallVecPush(numbers, i * 10);
+    }
+    TEST_ASSERT(numbers.heap == NULL && numbers.length == 4, "elements up to the inline count never allocate");
+    TEST_ASSERT(SmallVecAt(numbers, 3) == 30 && SmallVecData(numbers) == numbers.inline_data, "inline elements are readable");
+
+    SmallVecPush(numbers, 40);
+    TEST_ASSERT(numbers.heap != NULL && numbers.capacity == 8, "the first extra element spills to the heap");
+    for (int32_t i = 5; i < 100; i++) {
+      SmallVecPush(numbers, i * 10);
+    }
+
+    int32_t expected = 0;
+    bool intact = true;
+    SmallVecForEach(numbers, it) {
+      if (*it != expected) intact = false;
+      expected += 10;
+    }
+    TEST_ASSERT(intact && numbers.length == 100, "spilled elements keep their order");
+    TEST_ASSERT(*SmallVecPop(numbers) == 990 && numbers.length == 99, "pop returns the last element");
+
+    SmallVecFree(numbers);
+    TEST_ASSERT(numbers.heap == NULL && numbers.length == 0 && SmallVecCapacity(numbers) == 4, "free goes back to inline storage");
+  }
+  {
+    SMALLVEC_TYPE(SmallStrings, String, 2);
+    Arena *arena = ArenaCreate(1024);
+    SmallStrings parts = {0};
+    SmallVecPushWith(parts, S("a"), ArenaAllocator(arena));
+    SmallVecPushWith(parts, S("b"), ArenaAllocator(arena));
+    SmallVecPushWith(parts, S("c"), ArenaAllocator(arena));
+    TEST_ASSERT(StrEq(SmallVecAt(parts, 2), S("c")) && StrEq(SmallVecAt(parts, 0), S("a")), "small vector can spill into an arena");
+    SmallVecFreeWith(parts, ArenaAllocator(arena));
+    ArenaFree(arena);
+  }
+  TEST_END();
+}
+
+static void TestDeque(void) {
+  TEST_BEGIN("Deque");
+  {
+    DEQUE_TYPE(IntDeque, int32_t);
+    IntDeque deque = {0};
+    for (int32_t i = 0; i < 10; i++) {
+      DequePushBack(deque, i);
+    }
+    for (int32_t i = 1; i <= 10; i++) {
+      DequePushFront(deque, -i);
+    }
+    TEST_ASSERT(deque.length == 20 && deque.capacity == 32, "deque grows to the next power of two");
+    TEST_ASSERT(DequeAt(deque, 0) == -10 && DequeAt(deque, 19) == 9, "front and back pushes land on both ends");
+
+    bool ordered = true;
+    for (size_t i = 1; i < deque.length; i++) {
+      if (DequeAt(deque, i) <= DequeAt(deque, i - 1)) ordered = false;
+    }
+    TEST_ASSERT(ordered, "deque elements stay in order across the wrap");
+
+    TEST_ASSERT(DequePopFront(deque) == -10, "pop front returns the first element");
+    TEST_ASSERT(DequePopBack(deque) == 9, "pop back returns the last element");
+    TEST_ASSERT(deque.length == 18, "pops shrink the deque");
+    DequeFree(deque);
+    TEST_ASSERT(deque.data == NULL && deque.head == 0 && deque.length == 0 && deque.capacity == 0, "deque free resets it");
+  }
+  {
+    DEQUE_TYPE(IntDeque, int32_t);
+    IntDeque deque = {0};
+    for (int32_t i = 0; i < 100; i++) {
+      DequePushBack(deque, i);
+    }
+    for (int32_t i = 0; i < 90; i++) {
+      (void)DequePopFront(deque);
+    }
+    DequeFree(deque);
+    DequePushBack(deque, 7);
+    TEST_ASSERT(deque.length == 1 && DequeAt(deque, 0) == 7, "deque is reusable after a free with a moved head");
+    DequeFree(deque);
+  }
+  {
+    DEQUE_TYPE(IntDeque, int32_t);
+    IntDeque queue = {0};
+    int64_t expected = 0, sum = 0;
+    int32_t next = 0;
+    // Work queue pattern: the window slides around the ring many times
+    for (int32_t round = 0; round < 1000; round++) {
+      for (int32_t i = 0; i < 7; i++) {
+        DequePushBack(queue, next);
+        expected += next++;
+      }
+      for (int32_t i = 0; i < 5; i++) {
+        sum += DequePopFront(queue);
+      }
+    }
+    while (queue.length > 0) {
+      sum += DequePopFront(queue);
+    }
+    TEST_ASSERT(sum == expected, "queue pops every pushed element once");
+    TEST_ASSERT(queue.capacity == 2048, "queue capacity only tracks the live window");
+    DequeFree(queue);
+  }
+  TEST_END();
+}
+
+static void TestAllocatorVector(void) {
+  TEST_BEGIN("VectorAllocator");
+  {
+    VEC_TYPE(IntVector, int32_t);
+    Arena *arena = ArenaCreate(1024);
+    Allocator allocator = ArenaAllocator(arena);
+
+    IntVector numbers = {0};
+    for (int32_t i = 0; i < 1000; i++) {
+      VecPushWith(numbers, i, allocator);
+    }
+    TEST_ASSERT(numbers.length == 1000, "arena vector has every element");
+    TEST_ASSERT(numbers.data[0] == 0 && numbers.data[999] == 999, "arena vector kept its elements while growing");
+
+    VecFreeWith(numbers, allocator);
+    TEST_ASSERT(numbers.data == NULL && numbers.capacity == 0, "arena vector free resets the vector");
+    ArenaFree(arena);
+  }
+  {
+    VEC_TYPE(IntVector, int32_t);
+    IntVector numbers = {0};
+    VecReserveWith(numbers, 4, HeapAllocator());
+    for (int32_t i = 0; i < 100; i++) {
+      VecPushWith(numbers, i, HeapAllocator());
+    }
+    TEST_ASSERT(numbers.length == 100 && numbers.data[99] == 99, "heap allocator vector grows");
+    VecFreeWith(numbers, HeapAllocator());
+  }
+  {
+    VEC_TYPE(IntVector, int32_t);
+    Pool *pool = PoolCreate(sizeof(int32_t) * 128, DEFAULT_ALIGNMENT);
+    IntVector numbers = {0};
+    int32_t value = 7;
+    VecPushWith(numbers, value, PoolAllocator(pool));
+    TEST_ASSERT(numbers.capacity == 128 && numbers.data[0] == 7, "pool allocator hands out a fixed size element");
+    VecFreeWith(numbers, PoolAllocator(pool));
+    TEST_ASSERT(pool->free_list != NULL, "pool allocator free returns the element to the pool");
+    PoolDestroy(pool);
+  }
   TEST_END();
 }
 
@@ -200,6 +652,12 @@ int main(void) {
     TestAccess();
     TestCapacity();
     TestSort();
+    TestTypedSort();
+    TestParallelSort();
+    TestBulkOperations();
+    TestSmallVec();
+    TestDeque();
+    TestAllocatorVector();
   }
   EndTest();
 }